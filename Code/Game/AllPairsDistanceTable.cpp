@@ -0,0 +1,128 @@
+#include "Game/AllPairsDistanceTable.hpp"
+
+
+void AllPairsDistanceTable::Build(HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, std::vector<unsigned char> const& tileMovementCosts, int maxMovementCost)
+{
+	m_neighborTable = &neighborTable;
+	m_isTileBlocked = &isTileBlocked;
+	m_tileMovementCosts = &tileMovementCosts;
+	m_numTiles = neighborTable.GetNumTiles();
+
+	m_isWide = false;
+	m_wideDistances.clear();
+	m_wideDistances.shrink_to_fit();
+	m_narrowDistances.assign((size_t)m_numTiles * (size_t)m_numTiles, UNREACHABLE_NARROW);
+
+	m_rowField = DistanceField(neighborTable.m_dimensions);
+	m_rowFrontier.Reserve(m_numTiles);
+
+	PopulateRows(maxMovementCost);
+}
+
+void AllPairsDistanceTable::Clear()
+{
+	m_neighborTable = nullptr;
+	m_isTileBlocked = nullptr;
+	m_tileMovementCosts = nullptr;
+	m_numTiles = 0;
+	m_isWide = false;
+	m_narrowDistances.clear();
+	m_narrowDistances.shrink_to_fit();
+	m_wideDistances.clear();
+	m_wideDistances.shrink_to_fit();
+	m_rowField = DistanceField();
+}
+
+bool AllPairsDistanceTable::IsBuilt() const
+{
+	return m_numTiles > 0;
+}
+
+bool AllPairsDistanceTable::IsWide() const
+{
+	return m_isWide;
+}
+
+int AllPairsDistanceTable::GetNumTiles() const
+{
+	return m_numTiles;
+}
+
+size_t AllPairsDistanceTable::GetMemoryBytes() const
+{
+	return m_narrowDistances.capacity() * sizeof(unsigned char) + m_wideDistances.capacity() * sizeof(unsigned short);
+}
+
+int AllPairsDistanceTable::GetDistance(int fromTileIndex, int toTileIndex) const
+{
+	size_t entryIndex = (size_t)fromTileIndex * (size_t)m_numTiles + (size_t)toTileIndex;
+	if (m_isWide)
+	{
+		return m_wideDistances[entryIndex];
+	}
+
+	unsigned char distance = m_narrowDistances[entryIndex];
+	return (distance == UNREACHABLE_NARROW) ? DistanceField::UNREACHABLE : distance;
+}
+
+void AllPairsDistanceTable::CopyRow(DistanceField& out_distanceField, int fromTileIndex) const
+{
+	for (int tileIndex = 0; tileIndex < m_numTiles; tileIndex++)
+	{
+		out_distanceField.m_values[tileIndex] = (unsigned short)GetDistance(fromTileIndex, tileIndex);
+	}
+}
+
+void AllPairsDistanceTable::PopulateRows(int maxMovementCost)
+{
+	// Tables are capped at a few hundred tiles, so one search per row on the calling thread takes well under a frame
+	m_rowBucketQueue.Reserve(m_numTiles, maxMovementCost);
+	for (int rowTileIndex = 0; rowTileIndex < m_numTiles; rowTileIndex++)
+	{
+		if (maxMovementCost > 1)
+		{
+			PopulateWeightedDistanceField(m_rowField, *m_neighborTable, *m_tileMovementCosts, rowTileIndex, m_rowBucketQueue);
+		}
+		else
+		{
+			PopulateDistanceField(m_rowField, *m_neighborTable, *m_isTileBlocked, rowTileIndex, m_rowFrontier);
+		}
+
+		for (int tileIndex = 0; tileIndex < m_numTiles; tileIndex++)
+		{
+			SetDistance(rowTileIndex, tileIndex, m_rowField.m_values[tileIndex]);
+		}
+	}
+}
+
+void AllPairsDistanceTable::SetDistance(int fromTileIndex, int toTileIndex, int distance)
+{
+	if (!m_isWide && distance != DistanceField::UNREACHABLE && distance >= UNREACHABLE_NARROW)
+	{
+		Widen();
+	}
+
+	size_t entryIndex = (size_t)fromTileIndex * (size_t)m_numTiles + (size_t)toTileIndex;
+	if (m_isWide)
+	{
+		m_wideDistances[entryIndex] = (unsigned short)distance;
+	}
+	else
+	{
+		m_narrowDistances[entryIndex] = (distance == DistanceField::UNREACHABLE) ? UNREACHABLE_NARROW : (unsigned char)distance;
+	}
+}
+
+void AllPairsDistanceTable::Widen()
+{
+	m_wideDistances.resize(m_narrowDistances.size());
+	for (size_t entryIndex = 0; entryIndex < m_narrowDistances.size(); entryIndex++)
+	{
+		unsigned char distance = m_narrowDistances[entryIndex];
+		m_wideDistances[entryIndex] = (distance == UNREACHABLE_NARROW) ? DistanceField::UNREACHABLE : distance;
+	}
+
+	m_narrowDistances.clear();
+	m_narrowDistances.shrink_to_fit();
+	m_isWide = true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Game/DistanceField.hpp"
+
+#include <cstddef>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Cheapest movement cost from every tile to every other tile, for maps small enough that one table beats a search per query
+// Row s holds the costs from tile s, paying for each tile entered like everywhere else, so it equals the weighted distance field of s
+// Units are not considered: a value is a lower bound on any real move, and exact whenever the cheapest route is clear of units
+// Costs are stored as bytes while every reachable cost fits in one, and widen to 16 bits for good once one does not
+class AllPairsDistanceTable
+{
+public:
+	void Build(HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, std::vector<unsigned char> const& tileMovementCosts, int maxMovementCost);
+	void Clear();
+
+	bool IsBuilt() const;
+	bool IsWide() const;
+	int GetNumTiles() const;
+	size_t GetMemoryBytes() const;
+
+	// DistanceField::UNREACHABLE when toTileIndex cannot be reached, which also compares greater than any movement range
+	int GetDistance(int fromTileIndex, int toTileIndex) const;
+
+	// Fills a reset field with the costs from fromTileIndex, the same values PopulateWeightedDistanceField would write
+	void CopyRow(DistanceField& out_distanceField, int fromTileIndex) const;
+
+private:
+	void PopulateRows(int maxMovementCost);
+	void SetDistance(int fromTileIndex, int toTileIndex, int distance);
+	void Widen();
+
+public:
+	static constexpr unsigned char UNREACHABLE_NARROW = 0xFF;
+
+	HexNeighborTable const* m_neighborTable = nullptr;
+	std::vector<unsigned char> const* m_isTileBlocked = nullptr;
+	std::vector<unsigned char> const* m_tileMovementCosts = nullptr;
+	int m_numTiles = 0;
+	bool m_isWide = false;
+	std::vector<unsigned char> m_narrowDistances;
+	std::vector<unsigned short> m_wideDistances;
+
+private:
+	DistanceField m_rowField;
+	DistanceFieldFrontier m_rowFrontier;
+	DistanceFieldBucketQueue m_rowBucketQueue;
+};
@@ -0,0 +1,85 @@
+#include "Game/CursorPicker.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/Map.hpp"
+
+
+bool CursorPicker::Update(Map& map)
+{
+	Vec2 cursorNormalizedPosition = g_input->GetCursorNormalizedPosition();
+	if (IsUpToDate(map, cursorNormalizedPosition))
+	{
+		return false;
+	}
+
+	Camera const& worldCamera = map.m_game->m_worldCamera;
+	m_isValid = true;
+	m_map = &map;
+	m_cursorNormalizedPosition = cursorNormalizedPosition;
+	m_cameraPosition = worldCamera.GetPosition();
+	m_cameraOrientation = worldCamera.GetOrientation();
+	m_cameraFov = worldCamera.m_perspectiveFov;
+	m_cameraAspect = worldCamera.m_perspectiveAspect;
+
+	m_raycastResult = map.RaycastCursorVsMap();
+	m_hoveredTileCoords = IntVec2(-1, -1);
+	m_hoveredTileIndex = -1;
+	if (m_raycastResult.m_didImpact)
+	{
+		m_hoveredTileCoords = map.GetNearestPickableTileCoords(m_raycastResult.m_impactPosition.GetXY());
+		if (m_hoveredTileCoords != IntVec2(-1, -1))
+		{
+			m_hoveredTileIndex = map.GetTileIndexFromCoords(m_hoveredTileCoords);
+		}
+	}
+	m_numPicks++;
+
+	return true;
+}
+
+void CursorPicker::Invalidate()
+{
+	m_isValid = false;
+}
+
+bool CursorPicker::HasImpact() const
+{
+	return m_raycastResult.m_didImpact;
+}
+
+Vec3 const& CursorPicker::GetImpactPosition() const
+{
+	return m_raycastResult.m_impactPosition;
+}
+
+IntVec2 const& CursorPicker::GetHoveredTileCoords() const
+{
+	return m_hoveredTileCoords;
+}
+
+int CursorPicker::GetHoveredTileIndex() const
+{
+	return m_hoveredTileIndex;
+}
+
+bool CursorPicker::IsUpToDate(Map const& map, Vec2 const& cursorNormalizedPosition) const
+{
+	if (!m_isValid || m_map != &map)
+	{
+		return false;
+	}
+	if (cursorNormalizedPosition != m_cursorNormalizedPosition)
+	{
+		return false;
+	}
+
+	// Exact comparisons on purpose: the camera only ever holds still by not being written to
+	Camera const& worldCamera = map.m_game->m_worldCamera;
+	Vec3 cameraPosition = worldCamera.GetPosition();
+	EulerAngles cameraOrientation = worldCamera.GetOrientation();
+	return cameraPosition.x == m_cameraPosition.x && cameraPosition.y == m_cameraPosition.y && cameraPosition.z == m_cameraPosition.z
+		&& cameraOrientation.m_yawDegrees == m_cameraOrientation.m_yawDegrees && cameraOrientation.m_pitchDegrees == m_cameraOrientation.m_pitchDegrees
+		&& cameraOrientation.m_rollDegrees == m_cameraOrientation.m_rollDegrees
+		&& worldCamera.m_perspectiveFov == m_cameraFov && worldCamera.m_perspectiveAspect == m_cameraAspect;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+
+class Map;
+
+
+// Caches the cursor ray against the ground and the hex under it, so idle frames cost a few comparisons
+// The raycast and pick are redone only when the cursor, the world camera or the map changed since the last pick
+class CursorPicker
+{
+public:
+	// Returns true if the pick was redone this call
+	bool Update(Map& map);
+	void Invalidate();
+
+	bool HasImpact() const;
+	Vec3 const& GetImpactPosition() const;
+	IntVec2 const& GetHoveredTileCoords() const;
+	int GetHoveredTileIndex() const;
+
+private:
+	bool IsUpToDate(Map const& map, Vec2 const& cursorNormalizedPosition) const;
+
+public:
+	RaycastResult3D m_raycastResult;
+	IntVec2 m_hoveredTileCoords = IntVec2(-1, -1);
+	int m_hoveredTileIndex = -1;
+	int m_numPicks = 0;
+
+private:
+	bool m_isValid = false;
+	Map const* m_map = nullptr;
+	Vec2 m_cursorNormalizedPosition = Vec2::ZERO;
+	Vec3 m_cameraPosition = Vec3::ZERO;
+	EulerAngles m_cameraOrientation = EulerAngles::ZERO;
+	float m_cameraFov = 0.f;
+	float m_cameraAspect = 0.f;
+};
@@ -0,0 +1,325 @@
+#include "Game/DistanceField.hpp"
+
+#include "Game/HexGrid.hpp"
+
+
+void HexNeighborTable::Build(IntVec2 const& dimensions)
+{
+	m_dimensions = dimensions;
+	int numTiles = dimensions.x * dimensions.y;
+	m_firstNeighborIndexes.clear();
+	m_neighborTileIndexes.clear();
+	m_firstNeighborIndexes.reserve(numTiles + 1);
+	m_neighborTileIndexes.reserve(numTiles * 6);
+
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		m_firstNeighborIndexes.push_back((int)m_neighborTileIndexes.size());
+
+		IntVec2 tileCoords(tileIndex % dimensions.x, tileIndex / dimensions.x);
+		for (int neighborIndex = 0; neighborIndex < NUM_HEX_DIRECTIONS; neighborIndex++)
+		{
+			IntVec2 neighborCoords = GetHexNeighborCoords(tileCoords, neighborIndex);
+			if (neighborCoords.x < 0 || neighborCoords.x >= dimensions.x || neighborCoords.y < 0 || neighborCoords.y >= dimensions.y)
+			{
+				continue;
+			}
+
+			m_neighborTileIndexes.push_back(neighborCoords.y * dimensions.x + neighborCoords.x);
+		}
+	}
+	m_firstNeighborIndexes.push_back((int)m_neighborTileIndexes.size());
+}
+
+int HexNeighborTable::GetNumTiles() const
+{
+	return (int)m_firstNeighborIndexes.size() - 1;
+}
+
+void DistanceFieldFrontier::Reserve(int capacity)
+{
+	if ((int)m_tileIndexes.size() < capacity)
+	{
+		m_tileIndexes.resize(capacity);
+	}
+	Clear();
+}
+
+void DistanceFieldFrontier::Clear()
+{
+	m_head = 0;
+	m_tail = 0;
+	m_count = 0;
+}
+
+bool DistanceFieldFrontier::IsEmpty() const
+{
+	return m_count == 0;
+}
+
+void DistanceFieldFrontier::Push(int tileIndex)
+{
+	m_tileIndexes[m_tail] = tileIndex;
+	m_tail++;
+	if (m_tail == (int)m_tileIndexes.size())
+	{
+		m_tail = 0;
+	}
+	m_count++;
+}
+
+int DistanceFieldFrontier::Pop()
+{
+	int tileIndex = m_tileIndexes[m_head];
+	m_head++;
+	if (m_head == (int)m_tileIndexes.size())
+	{
+		m_head = 0;
+	}
+	m_count--;
+	return tileIndex;
+}
+
+void DistanceFieldBucketQueue::Reserve(int numTiles, int maxStepCost)
+{
+	if ((int)m_nextTileIndexes.size() < numTiles)
+	{
+		m_nextTileIndexes.resize(numTiles);
+		m_previousTileIndexes.resize(numTiles);
+	}
+	m_bucketHeads.resize(maxStepCost + 1);
+	Clear();
+}
+
+void DistanceFieldBucketQueue::Clear()
+{
+	for (int bucketIndex = 0; bucketIndex < (int)m_bucketHeads.size(); bucketIndex++)
+	{
+		m_bucketHeads[bucketIndex] = -1;
+	}
+	m_currentBucket = 0;
+	m_count = 0;
+}
+
+bool DistanceFieldBucketQueue::IsEmpty() const
+{
+	return m_count == 0;
+}
+
+void DistanceFieldBucketQueue::Insert(int tileIndex, int distance)
+{
+	int bucketIndex = distance % (int)m_bucketHeads.size();
+	int headTileIndex = m_bucketHeads[bucketIndex];
+
+	m_previousTileIndexes[tileIndex] = -1;
+	m_nextTileIndexes[tileIndex] = headTileIndex;
+	if (headTileIndex != -1)
+	{
+		m_previousTileIndexes[headTileIndex] = tileIndex;
+	}
+	m_bucketHeads[bucketIndex] = tileIndex;
+	m_count++;
+}
+
+void DistanceFieldBucketQueue::Remove(int tileIndex, int distance)
+{
+	int bucketIndex = distance % (int)m_bucketHeads.size();
+	int previousTileIndex = m_previousTileIndexes[tileIndex];
+	int nextTileIndex = m_nextTileIndexes[tileIndex];
+
+	if (previousTileIndex != -1)
+	{
+		m_nextTileIndexes[previousTileIndex] = nextTileIndex;
+	}
+	else
+	{
+		m_bucketHeads[bucketIndex] = nextTileIndex;
+	}
+
+	if (nextTileIndex != -1)
+	{
+		m_previousTileIndexes[nextTileIndex] = previousTileIndex;
+	}
+	m_count--;
+}
+
+int DistanceFieldBucketQueue::PopMin()
+{
+	while (m_bucketHeads[m_currentBucket] == -1)
+	{
+		m_currentBucket++;
+		if (m_currentBucket == (int)m_bucketHeads.size())
+		{
+			m_currentBucket = 0;
+		}
+	}
+
+	int tileIndex = m_bucketHeads[m_currentBucket];
+	int nextTileIndex = m_nextTileIndexes[tileIndex];
+	m_bucketHeads[m_currentBucket] = nextTileIndex;
+	if (nextTileIndex != -1)
+	{
+		m_previousTileIndexes[nextTileIndex] = -1;
+	}
+	m_count--;
+	return tileIndex;
+}
+
+DistanceField::DistanceField(IntVec2 const& dimensions)
+	: m_dimensions(dimensions)
+	, m_values(dimensions.x * dimensions.y, UNREACHABLE)
+{
+}
+
+unsigned short DistanceField::GetValueAtTile(IntVec2 const& tileCoords) const
+{
+	return m_values[tileCoords.y * m_dimensions.x + tileCoords.x];
+}
+
+unsigned short DistanceField::GetValueAtIndex(int tileIndex) const
+{
+	return m_values[tileIndex];
+}
+
+bool DistanceField::IsReachable(int tileIndex) const
+{
+	return m_values[tileIndex] != UNREACHABLE;
+}
+
+void PopulateDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, int goalTileIndex, DistanceFieldFrontier& frontier)
+{
+	PopulateMultiSourceDistanceField(out_distanceField, neighborTable, isTileBlocked, &goalTileIndex, 1, frontier);
+}
+
+void PopulateMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, std::vector<int> const& goalTileIndexes, DistanceFieldFrontier& frontier)
+{
+	PopulateMultiSourceDistanceField(out_distanceField, neighborTable, isTileBlocked, goalTileIndexes.data(), (int)goalTileIndexes.size(), frontier);
+}
+
+void PopulateMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, int const* goalTileIndexes, int numGoalTiles, DistanceFieldFrontier& frontier)
+{
+	int numTiles = neighborTable.GetNumTiles();
+	out_distanceField.m_dimensions = neighborTable.m_dimensions;
+	out_distanceField.m_values.assign(numTiles, DistanceField::UNREACHABLE);
+
+	// Every tile is pushed at most once, so a frontier with one slot per tile never overflows
+	// Seeding all goals at distance 0 gives every tile its distance to the nearest goal in the same single pass
+	frontier.Reserve(numTiles);
+	for (int goalIndex = 0; goalIndex < numGoalTiles; goalIndex++)
+	{
+		int goalTileIndex = goalTileIndexes[goalIndex];
+		if (out_distanceField.m_values[goalTileIndex] == 0)
+		{
+			continue;
+		}
+
+		frontier.Push(goalTileIndex);
+		out_distanceField.m_values[goalTileIndex] = 0;
+	}
+
+	int const* firstNeighborIndexes = neighborTable.m_firstNeighborIndexes.data();
+	int const* neighborTileIndexes = neighborTable.m_neighborTileIndexes.data();
+	unsigned short* distances = out_distanceField.m_values.data();
+
+	while (!frontier.IsEmpty())
+	{
+		int currentTileIndex = frontier.Pop();
+		int nextDistance = distances[currentTileIndex] + 1;
+		if (nextDistance >= DistanceField::UNREACHABLE)
+		{
+			// Tiles further than the largest storable distance are left unreachable
+			continue;
+		}
+
+		for (int neighborIndex = firstNeighborIndexes[currentTileIndex]; neighborIndex < firstNeighborIndexes[currentTileIndex + 1]; neighborIndex++)
+		{
+			int neighborTileIndex = neighborTileIndexes[neighborIndex];
+			if (isTileBlocked[neighborTileIndex] || distances[neighborTileIndex] != DistanceField::UNREACHABLE)
+			{
+				continue;
+			}
+
+			distances[neighborTileIndex] = (unsigned short)nextDistance;
+			frontier.Push(neighborTileIndex);
+		}
+	}
+}
+
+void PopulateWeightedDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, int goalTileIndex, DistanceFieldBucketQueue& bucketQueue)
+{
+	PopulateWeightedMultiSourceDistanceField(out_distanceField, neighborTable, tileMovementCosts, &goalTileIndex, 1, bucketQueue);
+}
+
+void PopulateWeightedMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, std::vector<int> const& goalTileIndexes, DistanceFieldBucketQueue& bucketQueue)
+{
+	PopulateWeightedMultiSourceDistanceField(out_distanceField, neighborTable, tileMovementCosts, goalTileIndexes.data(), (int)goalTileIndexes.size(), bucketQueue);
+}
+
+static void PopulateWeightedField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, int const* goalTileIndexes, int numGoalTiles, DistanceFieldBucketQueue& bucketQueue, bool isCostPaidOnLeaving)
+{
+	int numTiles = neighborTable.GetNumTiles();
+	out_distanceField.m_dimensions = neighborTable.m_dimensions;
+	out_distanceField.m_values.assign(numTiles, DistanceField::UNREACHABLE);
+
+	bucketQueue.Clear();
+	for (int goalIndex = 0; goalIndex < numGoalTiles; goalIndex++)
+	{
+		int goalTileIndex = goalTileIndexes[goalIndex];
+		if (out_distanceField.m_values[goalTileIndex] == 0)
+		{
+			continue;
+		}
+
+		bucketQueue.Insert(goalTileIndex, 0);
+		out_distanceField.m_values[goalTileIndex] = 0;
+	}
+
+	int const* firstNeighborIndexes = neighborTable.m_firstNeighborIndexes.data();
+	int const* neighborTileIndexes = neighborTable.m_neighborTileIndexes.data();
+	unsigned char const* movementCosts = tileMovementCosts.data();
+	unsigned short* distances = out_distanceField.m_values.data();
+
+	while (!bucketQueue.IsEmpty())
+	{
+		int currentTileIndex = bucketQueue.PopMin();
+		int currentDistance = distances[currentTileIndex];
+
+		for (int neighborIndex = firstNeighborIndexes[currentTileIndex]; neighborIndex < firstNeighborIndexes[currentTileIndex + 1]; neighborIndex++)
+		{
+			int neighborTileIndex = neighborTileIndexes[neighborIndex];
+			if (movementCosts[neighborTileIndex] == 0)
+			{
+				continue;
+			}
+
+			// Walking from the neighbor toward the goals enters the current tile, so that is the cost a flow field charges
+			int movementCost = isCostPaidOnLeaving ? movementCosts[currentTileIndex] : movementCosts[neighborTileIndex];
+
+			int nextDistance = currentDistance + movementCost;
+			int neighborDistance = distances[neighborTileIndex];
+			if (nextDistance >= neighborDistance)
+			{
+				// Also leaves tiles further than the largest storable distance unreachable
+				continue;
+			}
+
+			// A tile whose distance can still go down has been seen but not settled, so it is sitting in a bucket
+			if (neighborDistance != DistanceField::UNREACHABLE)
+			{
+				bucketQueue.Remove(neighborTileIndex, neighborDistance);
+			}
+			distances[neighborTileIndex] = (unsigned short)nextDistance;
+			bucketQueue.Insert(neighborTileIndex, nextDistance);
+		}
+	}
+}
+
+void PopulateWeightedMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, int const* goalTileIndexes, int numGoalTiles, DistanceFieldBucketQueue& bucketQueue)
+{
+	PopulateWeightedField(out_distanceField, neighborTable, tileMovementCosts, goalTileIndexes, numGoalTiles, bucketQueue, false);
+}
+
+void PopulateWeightedMultiSourceFlowField(DistanceField& out_flowField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, int const* goalTileIndexes, int numGoalTiles, DistanceFieldBucketQueue& bucketQueue)
+{
+	PopulateWeightedField(out_flowField, neighborTable, tileMovementCosts, goalTileIndexes, numGoalTiles, bucketQueue, true);
+}
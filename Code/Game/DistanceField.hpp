@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Compressed sparse row adjacency for a hex grid: the in-bounds neighbors of tile i are
+// m_neighborTileIndexes[m_firstNeighborIndexes[i]] up to (but not including) m_neighborTileIndexes[m_firstNeighborIndexes[i + 1]]
+// Neighbors are stored in HEX_DIRECTIONS order
+class HexNeighborTable
+{
+public:
+	void Build(IntVec2 const& dimensions);
+	int GetNumTiles() const;
+
+public:
+	IntVec2 m_dimensions = IntVec2::ZERO;
+	std::vector<int> m_firstNeighborIndexes;
+	std::vector<int> m_neighborTileIndexes;
+};
+
+//----------------------------------------------------------------------------------------------------------
+// Fixed capacity FIFO of tile indexes, reused across searches so a BFS never touches the heap
+class DistanceFieldFrontier
+{
+public:
+	void Reserve(int capacity);
+	void Clear();
+	bool IsEmpty() const;
+	void Push(int tileIndex);
+	int Pop();
+
+public:
+	std::vector<int> m_tileIndexes;
+	int m_head = 0;
+	int m_tail = 0;
+	int m_count = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------
+// Circular bucket queue for Dial's algorithm: with step costs in [1, maxStepCost] every queued distance lies within
+// maxStepCost of the smallest one, so maxStepCost + 1 buckets indexed by distance modulo the bucket count are enough
+// Buckets are intrusive doubly linked lists threaded through per-tile arrays, so inserts and removals never allocate
+class DistanceFieldBucketQueue
+{
+public:
+	void Reserve(int numTiles, int maxStepCost);
+	void Clear();
+	bool IsEmpty() const;
+	void Insert(int tileIndex, int distance);
+	void Remove(int tileIndex, int distance);
+	int PopMin();
+
+public:
+	std::vector<int> m_bucketHeads;
+	std::vector<int> m_nextTileIndexes;
+	std::vector<int> m_previousTileIndexes;
+	int m_currentBucket = 0;
+	int m_count = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------
+class DistanceField
+{
+public:
+	DistanceField() = default;
+	explicit DistanceField(IntVec2 const& dimensions);
+
+	unsigned short GetValueAtTile(IntVec2 const& tileCoords) const;
+	unsigned short GetValueAtIndex(int tileIndex) const;
+	bool IsReachable(int tileIndex) const;
+
+public:
+	static constexpr unsigned short UNREACHABLE = 0xFFFF;
+
+	IntVec2 m_dimensions = IntVec2::ZERO;
+	std::vector<unsigned short> m_values;
+};
+
+void PopulateDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, int goalTileIndex, DistanceFieldFrontier& frontier);
+
+// Multi-source variants seed every goal at distance 0, so each tile ends up holding its distance to the nearest goal
+void PopulateMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, std::vector<int> const& goalTileIndexes, DistanceFieldFrontier& frontier);
+void PopulateMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& isTileBlocked, int const* goalTileIndexes, int numGoalTiles, DistanceFieldFrontier& frontier);
+
+// Movement costs are paid on entering a tile, with 0 marking a blocked tile
+void PopulateWeightedDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, int goalTileIndex, DistanceFieldBucketQueue& bucketQueue);
+void PopulateWeightedMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, std::vector<int> const& goalTileIndexes, DistanceFieldBucketQueue& bucketQueue);
+void PopulateWeightedMultiSourceDistanceField(DistanceField& out_distanceField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, int const* goalTileIndexes, int numGoalTiles, DistanceFieldBucketQueue& bucketQueue);
+
+// Flow fields hold each tile's cost to walk to the nearest goal, paying for every tile entered on the way including the goal,
+// so descending one from any tile gives that tile's cheapest path without searching from it
+void PopulateWeightedMultiSourceFlowField(DistanceField& out_flowField, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, int const* goalTileIndexes, int numGoalTiles, DistanceFieldBucketQueue& bucketQueue);
@@ -0,0 +1,221 @@
+#include "Game/DistanceFieldBenchmark.hpp"
+
+#include "Game/DistanceField.hpp"
+#include "Game/HexGrid.hpp"
+
+#include "Engine/Core/Time.hpp"
+
+#include <queue>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Copy of the distance field BFS as it was before the neighbor table, kept so the benchmark has a baseline
+static void GetAllNeighboringTileCoordsLegacy(std::vector<IntVec2>& out_neighboringTiles, IntVec2 const& tileCoords)
+{
+	out_neighboringTiles.push_back(tileCoords + IntVec2(0, 1));
+	out_neighboringTiles.push_back(tileCoords + IntVec2(1, 0));
+	out_neighboringTiles.push_back(tileCoords + IntVec2(1, -1));
+	out_neighboringTiles.push_back(tileCoords + IntVec2(0, -1));
+	out_neighboringTiles.push_back(tileCoords + IntVec2(-1, 0));
+	out_neighboringTiles.push_back(tileCoords + IntVec2(-1, 1));
+}
+
+static void PopulateDistanceFieldLegacy(std::vector<float>& out_distanceField, IntVec2 const& dimensions, std::vector<unsigned char> const& isTileBlocked, IntVec2 const& goalCoords, float specialValue)
+{
+	int numTiles = dimensions.x * dimensions.y;
+	out_distanceField.resize(numTiles);
+	for (int distanceIndex = 0; distanceIndex < numTiles; distanceIndex++)
+	{
+		out_distanceField[distanceIndex] = specialValue;
+	}
+
+	std::queue<IntVec2> dirtyTileQueue;
+	dirtyTileQueue.push(goalCoords);
+	out_distanceField[goalCoords.y * dimensions.x + goalCoords.x] = 0.f;
+
+	while (!dirtyTileQueue.empty())
+	{
+		IntVec2 currentTileCoords = dirtyTileQueue.front();
+		dirtyTileQueue.pop();
+		float currentHeatValue = out_distanceField[currentTileCoords.y * dimensions.x + currentTileCoords.x];
+		std::vector<IntVec2> neighboringTileCoords;
+		GetAllNeighboringTileCoordsLegacy(neighboringTileCoords, currentTileCoords);
+
+		for (int neighborIndex = 0; neighborIndex < (int)neighboringTileCoords.size(); neighborIndex++)
+		{
+			IntVec2 const& neighborCoords = neighboringTileCoords[neighborIndex];
+			if (neighborCoords.x < 0 || neighborCoords.x >= dimensions.x || neighborCoords.y < 0 || neighborCoords.y >= dimensions.y)
+			{
+				continue;
+			}
+
+			int neighborTileIndex = neighborCoords.y * dimensions.x + neighborCoords.x;
+			if (!isTileBlocked[neighborTileIndex] && out_distanceField[neighborTileIndex] > currentHeatValue + 1.f)
+			{
+				out_distanceField[neighborTileIndex] = currentHeatValue + 1.f;
+				dirtyTileQueue.push(neighborCoords);
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------
+DistanceFieldBenchmarkResult RunDistanceFieldBenchmark(IntVec2 const& dimensions, int numIterations)
+{
+	constexpr float SPECIAL_VALUE = 9999.f;
+
+	DistanceFieldBenchmarkResult result;
+	result.m_dimensions = dimensions;
+	result.m_numIterations = numIterations;
+
+	// Deterministic scattering of roughly one blocked tile in eleven, with the goals kept open
+	int numTiles = dimensions.x * dimensions.y;
+	std::vector<unsigned char> isTileBlocked(numTiles, 0);
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		int tileX = tileIndex % dimensions.x;
+		int tileY = tileIndex / dimensions.x;
+		isTileBlocked[tileIndex] = ((tileX * 7 + tileY * 13) % 11 == 0) ? 1 : 0;
+	}
+
+	std::vector<IntVec2> goals;
+	for (int iterationIndex = 0; iterationIndex < numIterations; iterationIndex++)
+	{
+		IntVec2 goalCoords((iterationIndex * 37 + 1) % dimensions.x, (iterationIndex * 53 + 1) % dimensions.y);
+		isTileBlocked[goalCoords.y * dimensions.x + goalCoords.x] = 0;
+		goals.push_back(goalCoords);
+	}
+
+	std::vector<float> legacyField;
+	double legacyStartTime = GetCurrentTimeSeconds();
+	for (int iterationIndex = 0; iterationIndex < numIterations; iterationIndex++)
+	{
+		PopulateDistanceFieldLegacy(legacyField, dimensions, isTileBlocked, goals[iterationIndex], SPECIAL_VALUE);
+	}
+	double legacyEndTime = GetCurrentTimeSeconds();
+
+	// Table and frontier setup happens once per map, so it is left out of the timing just like Map does at load
+	HexNeighborTable neighborTable;
+	neighborTable.Build(dimensions);
+	DistanceFieldFrontier frontier;
+	frontier.Reserve(numTiles);
+	DistanceField distanceField(dimensions);
+
+	double neighborTableStartTime = GetCurrentTimeSeconds();
+	for (int iterationIndex = 0; iterationIndex < numIterations; iterationIndex++)
+	{
+		IntVec2 const& goalCoords = goals[iterationIndex];
+		PopulateDistanceField(distanceField, neighborTable, isTileBlocked, goalCoords.y * dimensions.x + goalCoords.x, frontier);
+	}
+	double neighborTableEndTime = GetCurrentTimeSeconds();
+
+	// Both fields hold the last goal, so compare them tile by tile
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		bool isLegacyReachable = legacyField[tileIndex] != SPECIAL_VALUE;
+		if (isLegacyReachable != distanceField.IsReachable(tileIndex) || (isLegacyReachable && (int)legacyField[tileIndex] != (int)distanceField.m_values[tileIndex]))
+		{
+			result.m_numMismatchedTiles++;
+		}
+	}
+
+	result.m_legacyMillisecondsPerField = 1000.0 * (legacyEndTime - legacyStartTime) / (double)numIterations;
+	result.m_neighborTableMillisecondsPerField = 1000.0 * (neighborTableEndTime - neighborTableStartTime) / (double)numIterations;
+	return result;
+}
+
+//----------------------------------------------------------------------------------------------------------
+// Same BFS written once against HexGrid, so the only difference between the two timings is whether the layout is known at compile time
+template <typename Layout>
+static void PopulateHexGridDistanceField(HexGrid<unsigned short, Layout>& out_distanceField, HexGrid<unsigned char, Layout> const& isTileBlocked, IntVec2 const& goalCoords, std::vector<int>& frontier)
+{
+	constexpr unsigned short UNREACHABLE_DISTANCE = 0xFFFF;
+
+	out_distanceField.Fill(UNREACHABLE_DISTANCE);
+	frontier.clear();
+
+	int goalTileIndex = out_distanceField.GetTileIndex(goalCoords);
+	out_distanceField[goalTileIndex] = 0;
+	frontier.push_back(goalTileIndex);
+
+	for (int frontierIndex = 0; frontierIndex < (int)frontier.size(); frontierIndex++)
+	{
+		int tileIndex = frontier[frontierIndex];
+		IntVec2 tileCoords = out_distanceField.GetTileCoords(tileIndex);
+		unsigned short neighborDistance = (unsigned short)(out_distanceField[tileIndex] + 1);
+
+		for (int directionIndex = 0; directionIndex < NUM_HEX_DIRECTIONS; directionIndex++)
+		{
+			IntVec2 neighborCoords = GetHexNeighborCoords(tileCoords, directionIndex);
+			if (!out_distanceField.IsInBounds(neighborCoords))
+			{
+				continue;
+			}
+
+			int neighborTileIndex = out_distanceField.GetTileIndex(neighborCoords);
+			if (!isTileBlocked[neighborTileIndex] && out_distanceField[neighborTileIndex] > neighborDistance)
+			{
+				out_distanceField[neighborTileIndex] = neighborDistance;
+				frontier.push_back(neighborTileIndex);
+			}
+		}
+	}
+}
+
+HexGridLayoutBenchmarkResult RunHexGridLayoutBenchmark(int numIterations)
+{
+	HexGridLayoutBenchmarkResult result;
+	result.m_numIterations = numIterations;
+
+	DynamicHexLayout dynamicLayout(HexLayout12x12::GetDimensions());
+	HexGrid<unsigned char> dynamicIsTileBlocked(dynamicLayout, 0);
+	HexGrid<unsigned char, HexLayout12x12> fixedIsTileBlocked(HexLayout12x12(), 0);
+	for (int tileIndex = 0; tileIndex < HexLayout12x12::GetNumTiles(); tileIndex++)
+	{
+		IntVec2 tileCoords = HexLayout12x12::GetTileCoords(tileIndex);
+		unsigned char isBlocked = ((tileCoords.x * 7 + tileCoords.y * 13) % 11 == 0) ? 1 : 0;
+		dynamicIsTileBlocked[tileIndex] = isBlocked;
+		fixedIsTileBlocked[tileIndex] = isBlocked;
+	}
+
+	std::vector<IntVec2> goals;
+	for (int iterationIndex = 0; iterationIndex < numIterations; iterationIndex++)
+	{
+		IntVec2 goalCoords((iterationIndex * 37 + 1) % HexLayout12x12::GetWidth(), (iterationIndex * 53 + 1) % HexLayout12x12::GetHeight());
+		dynamicIsTileBlocked.Get(goalCoords) = 0;
+		fixedIsTileBlocked.Get(goalCoords) = 0;
+		goals.push_back(goalCoords);
+	}
+
+	std::vector<int> frontier;
+	frontier.reserve(HexLayout12x12::GetNumTiles());
+	HexGrid<unsigned short> dynamicField(dynamicLayout);
+	HexGrid<unsigned short, HexLayout12x12> fixedField;
+
+	double dynamicStartTime = GetCurrentTimeSeconds();
+	for (int iterationIndex = 0; iterationIndex < numIterations; iterationIndex++)
+	{
+		PopulateHexGridDistanceField(dynamicField, dynamicIsTileBlocked, goals[iterationIndex], frontier);
+	}
+	double dynamicEndTime = GetCurrentTimeSeconds();
+
+	double fixedStartTime = GetCurrentTimeSeconds();
+	for (int iterationIndex = 0; iterationIndex < numIterations; iterationIndex++)
+	{
+		PopulateHexGridDistanceField(fixedField, fixedIsTileBlocked, goals[iterationIndex], frontier);
+	}
+	double fixedEndTime = GetCurrentTimeSeconds();
+
+	for (int tileIndex = 0; tileIndex < HexLayout12x12::GetNumTiles(); tileIndex++)
+	{
+		if (dynamicField[tileIndex] != fixedField[tileIndex])
+		{
+			result.m_numMismatchedTiles++;
+		}
+	}
+
+	result.m_dynamicLayoutMillisecondsPerField = 1000.0 * (dynamicEndTime - dynamicStartTime) / (double)numIterations;
+	result.m_fixedLayoutMillisecondsPerField = 1000.0 * (fixedEndTime - fixedStartTime) / (double)numIterations;
+	return result;
+}
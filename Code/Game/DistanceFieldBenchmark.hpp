@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Engine/Math/IntVec2.hpp"
+
+
+struct DistanceFieldBenchmarkResult
+{
+public:
+	IntVec2 m_dimensions = IntVec2::ZERO;
+	int m_numIterations = 0;
+	double m_legacyMillisecondsPerField = 0.0;
+	double m_neighborTableMillisecondsPerField = 0.0;
+	int m_numMismatchedTiles = 0;
+};
+
+struct HexGridLayoutBenchmarkResult
+{
+public:
+	int m_numIterations = 0;
+	double m_dynamicLayoutMillisecondsPerField = 0.0;
+	double m_fixedLayoutMillisecondsPerField = 0.0;
+	int m_numMismatchedTiles = 0;
+};
+
+DistanceFieldBenchmarkResult RunDistanceFieldBenchmark(IntVec2 const& dimensions, int numIterations);
+HexGridLayoutBenchmarkResult RunHexGridLayoutBenchmark(int numIterations);
@@ -1,6 +1,7 @@
 #include "Game/Game.hpp"
 
 #include "Game/App.hpp"
+#include "Game/DistanceFieldBenchmark.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Map.hpp"
 #include "Game/MapDefinition.hpp"
@@ -9,6 +10,7 @@
 #include "Game/Unit.hpp"
 #include "Game/UnitDefinition.hpp"
 #include "Game/Particle.hpp"
+#include "Game/ParticleRenderer.hpp"
 
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Networking/NetSystem.hpp"
@@ -19,6 +21,8 @@
 #include "Engine/Renderer/Spritesheet.hpp"
 #include "Engine/UI/UISystem.hpp"
 
+#include <algorithm>
+
 
 bool Game::Event_RemoteCommand(EventArgs& args)
 {
@@ -93,6 +97,29 @@ bool Game::Event_LoadMap(EventArgs& args)
 	return true;
 }
 
+bool Game::Event_BenchmarkDistanceFields(EventArgs& args)
+{
+	UNUSED(args);
+
+	IntVec2 const benchmarkDimensions[] = { IntVec2(12, 12), IntVec2(128, 128), IntVec2(1024, 1024) };
+	int const benchmarkIterations[] = { 2000, 100, 5 };
+
+	for (int benchmarkIndex = 0; benchmarkIndex < 3; benchmarkIndex++)
+	{
+		DistanceFieldBenchmarkResult result = RunDistanceFieldBenchmark(benchmarkDimensions[benchmarkIndex], benchmarkIterations[benchmarkIndex]);
+		g_console->AddLine(DevConsole::INFO_MAJOR, Stringf("%dx%d (%d fields): legacy %.4f ms, neighbor table %.4f ms, %.1fx faster, %d mismatched tiles",
+			result.m_dimensions.x, result.m_dimensions.y, result.m_numIterations, result.m_legacyMillisecondsPerField, result.m_neighborTableMillisecondsPerField,
+			result.m_legacyMillisecondsPerField / result.m_neighborTableMillisecondsPerField, result.m_numMismatchedTiles), false);
+	}
+
+	HexGridLayoutBenchmarkResult layoutResult = RunHexGridLayoutBenchmark(2000);
+	g_console->AddLine(DevConsole::INFO_MAJOR, Stringf("12x12 HexGrid (%d fields): dynamic layout %.4f ms, fixed layout %.4f ms, %.1fx faster, %d mismatched tiles",
+		layoutResult.m_numIterations, layoutResult.m_dynamicLayoutMillisecondsPerField, layoutResult.m_fixedLayoutMillisecondsPerField,
+		layoutResult.m_dynamicLayoutMillisecondsPerField / layoutResult.m_fixedLayoutMillisecondsPerField, layoutResult.m_numMismatchedTiles), false);
+
+	return true;
+}
+
 bool Game::Event_PlayerReady(EventArgs& args)
 {
 	UNUSED(args);
@@ -162,6 +189,28 @@ bool Game::Event_Move(EventArgs& args)
 	return true;
 }
 
+bool Game::Event_ToggleGroupUnit(EventArgs& args)
+{
+	UNUSED(args);
+
+	g_app->m_game->ToggleFocusedUnitInGroup();
+
+	return true;
+}
+
+bool Game::Event_GroupMove(EventArgs& args)
+{
+	IntVec2 hexCoords = args.GetValue("hexCoords", IntVec2(-1, -1));
+	if (hexCoords == IntVec2(-1, -1))
+	{
+		return false;
+	}
+
+	g_app->m_game->GroupMove(hexCoords);
+
+	return true;
+}
+
 bool Game::Event_Stay(EventArgs& args)
 {
 	UNUSED(args);
@@ -270,13 +319,6 @@ void Game::StartTurn()
 
 void Game::SetFocusedHex(IntVec2 const& hexCoords)
 {
-	for (int tileIndex = 0; tileIndex < (int)m_currentMap->m_tiles.size(); tileIndex++)
-	{
-		m_currentMap->m_tiles[tileIndex].m_isHovered = false;
-	}
-
-	int tileIndex = m_currentMap->GetTileIndexFromCoords(hexCoords);
-	m_currentMap->m_tiles[tileIndex].m_isHovered = true;
 	m_currentMap->m_hoveredTile = hexCoords;
 }
 
@@ -287,6 +329,11 @@ void Game::SelectFocusedUnit()
 	{
 		currentPlayer->m_selectedUnit->m_isSelected = false;
 	}
+	for (int unitIndex = 0; unitIndex < (int)currentPlayer->m_groupUnits.size(); unitIndex++)
+	{
+		currentPlayer->m_groupUnits[unitIndex]->m_isSelected = false;
+	}
+	currentPlayer->m_groupUnits.clear();
 
 	Unit* hoveredUnit = currentPlayer->GetUnitFromTileCoords(m_currentMap->m_hoveredTile);
 	if (hoveredUnit && !hoveredUnit->m_ordersIssued)
@@ -308,30 +355,22 @@ void Game::SelectNextUnit()
 void Game::Move(IntVec2 const& tileCoords)
 {
 	Player* currentPlayer = GetCurrentPlayer();
-	Player* waitingPlayer = GetWaitingPlayer();
 
-	for (int unitIndex = 0; unitIndex < (int)currentPlayer->m_units.size(); unitIndex++)
+	if (tileCoords.x < 0 || tileCoords.x >= m_currentMap->m_definition.m_dimensions.x || tileCoords.y < 0 || tileCoords.y >= m_currentMap->m_definition.m_dimensions.y)
 	{
-		if (currentPlayer->m_units[unitIndex]->m_tileCoords == tileCoords)
-		{
-			return;
-		}
-	}
-	for (int unitIndex = 0; unitIndex < (int)waitingPlayer->m_units.size(); unitIndex++)
-	{
-		if (waitingPlayer->m_units[unitIndex]->m_tileCoords == tileCoords)
-		{
-			return;
-		}
+		return;
 	}
 
-	int tileIndex = m_currentMap->GetTileIndexFromCoords(tileCoords);
-	if (m_currentMap->m_tiles[tileIndex].m_definition.m_isBlocked)
+	// The table ignores units, which only ever make a move dearer, so a tile it puts out of range needs no search to turn down
+	AllPairsDistanceTable const& allPairsDistanceTable = m_currentMap->m_allPairsDistanceTable;
+	Unit const* selectedUnit = currentPlayer->m_selectedUnit;
+	if (allPairsDistanceTable.IsBuilt() && allPairsDistanceTable.GetDistance(m_currentMap->GetTileIndexFromCoords(selectedUnit->m_tileCoords), m_currentMap->GetTileIndexFromCoords(tileCoords)) > selectedUnit->m_definition.m_movementRange)
 	{
 		return;
 	}
 
-	if (m_currentMap->GetHexTaxicabDistance(tileCoords, currentPlayer->m_selectedUnit->m_tileCoords) > currentPlayer->m_selectedUnit->m_definition.m_movementRange)
+	ReachableSet const& reachableSet = m_currentMap->ComputeReachableSet(currentPlayer->m_selectedUnit);
+	if (!reachableSet.IsTileReachable(m_currentMap->GetTileIndexFromCoords(tileCoords)))
 	{
 		return;
 	}
@@ -340,6 +379,54 @@ void Game::Move(IntVec2 const& tileCoords)
 	currentPlayer->m_turnState = TurnState::UNIT_SELECTED_ATTACK;
 }
 
+void Game::ToggleFocusedUnitInGroup()
+{
+	Player* currentPlayer = GetCurrentPlayer();
+	Unit* hoveredUnit = currentPlayer->GetUnitFromTileCoords(m_currentMap->m_hoveredTile);
+	if (!hoveredUnit || hoveredUnit->m_ordersIssued || hoveredUnit->m_didMove)
+	{
+		return;
+	}
+
+	std::vector<Unit*>& groupUnits = currentPlayer->m_groupUnits;
+	auto groupUnitIter = std::find(groupUnits.begin(), groupUnits.end(), hoveredUnit);
+	if (groupUnitIter != groupUnits.end())
+	{
+		groupUnits.erase(groupUnitIter);
+		hoveredUnit->m_isSelected = false;
+	}
+	else
+	{
+		groupUnits.push_back(hoveredUnit);
+		hoveredUnit->m_isSelected = true;
+	}
+}
+
+void Game::GroupMove(IntVec2 const& tileCoords)
+{
+	Player* currentPlayer = GetCurrentPlayer();
+	std::vector<Unit*>& groupUnits = currentPlayer->m_groupUnits;
+
+	if (tileCoords.x < 0 || tileCoords.x >= m_currentMap->m_definition.m_dimensions.x || tileCoords.y < 0 || tileCoords.y >= m_currentMap->m_definition.m_dimensions.y)
+	{
+		return;
+	}
+
+	std::vector<std::vector<IntVec2>> tileCoordsPaths;
+	m_currentMap->PlanGroupMove(tileCoordsPaths, groupUnits, tileCoords);
+
+	for (int unitIndex = 0; unitIndex < (int)groupUnits.size(); unitIndex++)
+	{
+		Unit* unit = groupUnits[unitIndex];
+		if ((int)tileCoordsPaths[unitIndex].size() > 1)
+		{
+			unit->MoveAlongPath(tileCoordsPaths[unitIndex]);
+		}
+		unit->m_isSelected = false;
+	}
+	groupUnits.clear();
+}
+
 void Game::Stay()
 {
 	Player* currentPlayer = GetCurrentPlayer();
@@ -359,8 +446,7 @@ void Game::Attack()
 	Player* currentPlayer = GetCurrentPlayer();
 	Player* waitingPlayer = GetWaitingPlayer();
 
-	int attackDistance = m_currentMap->GetHexTaxicabDistance(currentPlayer->m_selectedUnit->m_tileCoords, m_currentMap->m_hoveredTile);
-	if (attackDistance < currentPlayer->m_selectedUnit->m_definition.m_attackRange.m_min || attackDistance > currentPlayer->m_selectedUnit->m_definition.m_attackRange.m_max)
+	if (!m_currentMap->CanUnitAttackTile(currentPlayer->m_selectedUnit, m_currentMap->m_hoveredTile))
 	{
 		return;
 	}
@@ -384,7 +470,16 @@ void Game::Attack()
 void Game::Cancel()
 {
 	Player* currentPlayer = GetCurrentPlayer();
-	if (currentPlayer->m_turnState == TurnState::NO_SELECTION || currentPlayer->m_turnState == TurnState::END_TURN)
+	if (currentPlayer->m_turnState == TurnState::NO_SELECTION)
+	{
+		for (int unitIndex = 0; unitIndex < (int)currentPlayer->m_groupUnits.size(); unitIndex++)
+		{
+			currentPlayer->m_groupUnits[unitIndex]->m_isSelected = false;
+		}
+		currentPlayer->m_groupUnits.clear();
+		return;
+	}
+	if (currentPlayer->m_turnState == TurnState::END_TURN)
 	{
 		return;
 	}
@@ -409,6 +504,7 @@ void Game::EndTurn()
 	if (!m_hasGameEnded)
 	{
 		waitingPlayer->m_turnState = TurnState::NO_SELECTION;
+		m_currentMap->RefreshInfluenceMaps();
 	}
 	g_input->HandleKeyReleased('Y');
 }
@@ -515,15 +611,43 @@ Player* Game::GetLocalPlayer() const
 	return nullptr;
 }
 
-void Game::SpawnParticle(Vec3 const& startPos, Vec3 const& velocity, float rotation, float rotationSpeed, float size, float lifetime, std::string const& textureName, Rgba8 const& color, float startAlpha, float endAlpha, float startAlphaTime, float endAlphaTime, float startScale, float endScale, float startScaleTime, float endScaleTime, float startSpeedMultiplier, float endSpeedMultiplier, float startSpeedTime, float endSpeedTime)
+Player* Game::GetViewingPlayer() const
+{
+	if (m_gameType == GameType::NETWORK)
+	{
+		return GetLocalPlayer();
+	}
+
+	// Local games share one screen, so the fog follows whoever is taking their turn
+	return GetCurrentPlayer();
+}
+
+bool Game::IsUnitVisible(Unit const* unit) const
+{
+	if (m_hasGameEnded)
+	{
+		return true;
+	}
+
+	Player* viewingPlayer = GetViewingPlayer();
+	if (!viewingPlayer || unit->m_owner == viewingPlayer)
+	{
+		return true;
+	}
+
+	return viewingPlayer->IsTileVisible(unit->m_tileCoords);
+}
+
+void Game::SpawnParticle(Vec3 const& startPos, Vec3 const& velocity, float rotation, float rotationSpeed, float size, float lifetime, int spriteHandle, Rgba8 const& color, float startAlpha, float endAlpha, float startAlphaTime, float endAlphaTime, float startScale, float endScale, float startScaleTime, float endScaleTime, float startSpeedMultiplier, float endSpeedMultiplier, float startSpeedTime, float endSpeedTime)
 {
-	Particle particle(startPos, velocity, rotation, rotationSpeed, size, &m_gameClock, lifetime, textureName, color, startAlpha, endAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+	Particle particle(startPos, velocity, rotation, rotationSpeed, size, &m_gameClock, lifetime, spriteHandle, color, startAlpha, endAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	m_particles.emplace_back(particle);
 }
 
 Game::Game()
 {
 	LoadAssets();
+	m_particleRenderer = new ParticleRenderer();
 	
 	m_worldCamera.SetPerspectiveView(g_window->GetAspect(), 60.f, 0.01f, 100.f);
 	m_worldCamera.SetRenderBasis(Vec3::SKYWARD, Vec3::WEST, Vec3::NORTH);
@@ -533,12 +657,15 @@ Game::Game()
 	SubscribeEventCallbackFunction("BurstTest", Event_BurstTest, "Send a burst of test messages over the network");
 	SubscribeEventCallbackFunction("RemoteHelp", Event_RemoteHelp, "Send help text over the network");
 	SubscribeEventCallbackFunction("LoadMap", Event_LoadMap, "Load a map with the specified name");
+	SubscribeEventCallbackFunction("BenchmarkDistanceFields", Event_BenchmarkDistanceFields, "Time distance field generation on 12x12, 128x128 and 1024x1024 grids, and dynamic vs fixed 12x12 HexGrid layouts");
 	SubscribeEventCallbackFunction("PlayerReady", Event_PlayerReady, "Indicate that the player is ready");
 	SubscribeEventCallbackFunction("SetFocusedHex", Event_SetFocusedHexCoords, "Set coordinates for the focused hex");
 	SubscribeEventCallbackFunction("SelectFocusedUnit", Event_SelectFocusedUnit, "Set coordinates for the focused hex");
 	SubscribeEventCallbackFunction("SelectPreviousUnit", Event_SelectPreviousUnit, "Set coordinates for the focused hex");
 	SubscribeEventCallbackFunction("SelectNextUnit", Event_SelectNextUnit, "Set coordinates for the focused hex");
 	SubscribeEventCallbackFunction("Move", Event_Move, "Set coordinates for the focused hex");
+	SubscribeEventCallbackFunction("ToggleGroupUnit", Event_ToggleGroupUnit, "Add or remove the focused unit from the group");
+	SubscribeEventCallbackFunction("GroupMove", Event_GroupMove, "Move the group toward the specified hex");
 	SubscribeEventCallbackFunction("Stay", Event_Stay, "Set coordinates for the focused hex");
 	SubscribeEventCallbackFunction("HoldFire", Event_HoldFire, "Set coordinates for the focused hex");
 	SubscribeEventCallbackFunction("Attack", Event_Attack, "Set coordinates for the focused hex");
@@ -555,6 +682,8 @@ Game::Game()
 
 Game::~Game()
 {
+	delete m_particleRenderer;
+	m_particleRenderer = nullptr;
 }
 
 void Game::LoadAssets()
@@ -587,6 +716,83 @@ void Game::SortParticles()
 	});
 }
 
+void Game::RenderUnits() const
+{
+	m_unitRenderList.clear();
+	Player* players[] = { m_player1, m_player2 };
+	for (int playerIndex = 0; playerIndex < 2; playerIndex++)
+	{
+		if (!players[playerIndex])
+		{
+			continue;
+		}
+		for (int unitIndex = 0; unitIndex < (int)players[playerIndex]->m_units.size(); unitIndex++)
+		{
+			Unit const* unit = players[playerIndex]->m_units[unitIndex];
+			if (IsUnitVisible(unit))
+			{
+				m_unitRenderList.push_back(unit);
+			}
+		}
+	}
+	if (m_unitRenderList.empty() || !m_currentMap)
+	{
+		return;
+	}
+
+	// Units of the same model are drawn back to back, and each pass sets its render state once rather than once per unit
+	std::stable_sort(m_unitRenderList.begin(), m_unitRenderList.end(), [](Unit const* unitA, Unit const* unitB)
+	{
+		return unitA->m_definition.m_model < unitB->m_definition.m_model;
+	});
+
+	g_renderer->BeginCamera(m_worldCamera);
+	{
+		g_renderer->SetBlendMode(BlendMode::OPAQUE);
+		g_renderer->SetDepthMode(DepthMode::ENABLED);
+		g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_BACK);
+		g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
+		g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
+		g_renderer->BindTexture(nullptr);
+		g_renderer->BindShader(m_currentMap->m_definition.m_shader);
+		for (int unitIndex = 0; unitIndex < (int)m_unitRenderList.size(); unitIndex++)
+		{
+			Unit const* unit = m_unitRenderList[unitIndex];
+			g_renderer->SetModelConstants(unit->GetModelTransform(), unit->GetModelColor());
+			g_renderer->DrawVertexBuffer(unit->m_definition.m_model->GetVertexBuffer(), unit->m_definition.m_model->GetVertexCount());
+		}
+
+		// Planar shadows squash each model onto the ground along the sun direction, which is the same for every unit
+		Vec3 sunDirection = m_sunOrientation.GetAsMatrix_iFwd_jLeft_kUp().GetIBasis3D();
+		if (sunDirection.z < 0.f)
+		{
+			Vec3 groundIBasis(1.f, 0.f, 0.f);
+			Vec3 groundJBasis(0.f, 1.f, 0.f);
+			Vec3 groundKBasis(-(sunDirection.x / sunDirection.z), -(sunDirection.y / sunDirection.z), 0.f);
+			Vec3 groundTranslation(0.f, 0.f, 0.001f);
+			Mat44 const groundShadowMatrix(groundIBasis, groundJBasis, groundKBasis, groundTranslation);
+			Rgba8 const shadowColor(0, 0, 0, 195);
+
+			g_renderer->SetBlendMode(BlendMode::ALPHA);
+			g_renderer->SetDepthMode(DepthMode::READ_ONLY_LESS_EQUAL);
+			for (int unitIndex = 0; unitIndex < (int)m_unitRenderList.size(); unitIndex++)
+			{
+				Unit const* unit = m_unitRenderList[unitIndex];
+				Mat44 shadowMatrix = groundShadowMatrix;
+				shadowMatrix.Append(unit->GetModelTransform());
+				g_renderer->SetModelConstants(shadowMatrix, shadowColor);
+				g_renderer->DrawVertexBuffer(unit->m_definition.m_model->GetVertexBuffer(), unit->m_definition.m_model->GetVertexCount());
+			}
+		}
+
+		for (int unitIndex = 0; unitIndex < (int)m_unitRenderList.size(); unitIndex++)
+		{
+			m_unitRenderList[unitIndex]->RenderFloatingDamage();
+		}
+	}
+	g_renderer->EndCamera(m_worldCamera);
+}
+
 void Game::Update()
 {
 	float deltaSeconds = m_gameClock.GetDeltaSeconds();
@@ -752,6 +958,11 @@ void Game::UpdateGame(float deltaSeconds)
 		m_player2->DeleteGarbageUnits();
 	}
 
+	if (m_currentMap)
+	{
+		m_currentMap->UpdateOverlay();
+	}
+
 	Player* currentPlayer = GetCurrentPlayer();
 	if (m_hasGameEnded)
 	{
@@ -921,21 +1132,11 @@ void Game::RenderGame() const
 			}
 		}
 	}
-	if (m_player1)
-	{
-		m_player1->Render();
-	}
-	if (m_player2)
-	{
-		m_player2->Render();
-	}
+	RenderUnits();
 
 	g_renderer->BeginCamera(m_worldCamera);
 	{
-		for (int particleIndex = 0; (int)particleIndex < m_particles.size(); particleIndex++)
-		{
-			m_particles[particleIndex].Render(m_worldCamera);
-		}
+		m_particleRenderer->Render(m_particles, m_worldCamera);
 	}
 	g_renderer->EndCamera(m_worldCamera);
 
@@ -17,6 +17,8 @@ class App;
 class Map;
 class Player;
 class Particle;
+class ParticleRenderer;
+class Unit;
 
 
 enum class GameState
@@ -50,6 +52,7 @@ public:
 	static bool					Event_BurstTest										(EventArgs& args);
 	static bool					Event_RemoteHelp									(EventArgs& args);
 	static bool					Event_LoadMap										(EventArgs& args);
+	static bool					Event_BenchmarkDistanceFields						(EventArgs& args);
 
 	static bool					Event_PlayerReady(EventArgs& args);
 	static bool					Event_StartTurn(EventArgs& args);
@@ -58,6 +61,8 @@ public:
 	static bool					Event_SelectPreviousUnit(EventArgs& args);
 	static bool					Event_SelectNextUnit(EventArgs& args);
 	static bool					Event_Move(EventArgs& args);
+	static bool					Event_ToggleGroupUnit(EventArgs& args);
+	static bool					Event_GroupMove(EventArgs& args);
 	static bool					Event_Stay(EventArgs& args);
 	static bool					Event_HoldFire(EventArgs& args);
 	static bool					Event_Attack(EventArgs& args);
@@ -77,6 +82,8 @@ public:
 	void						SelectPreviousUnit();
 	void						SelectNextUnit();
 	void						Move(IntVec2 const& tileCoords);
+	void						ToggleFocusedUnitInGroup();
+	void						GroupMove(IntVec2 const& tileCoords);
 	void						Stay();
 	void						HoldFire();
 	void						Attack();
@@ -88,8 +95,10 @@ public:
 	Player* GetCurrentPlayer() const;
 	Player* GetWaitingPlayer() const;
 	Player* GetLocalPlayer() const;
+	Player* GetViewingPlayer() const;
+	bool IsUnitVisible(Unit const* unit) const;
 
-	void SpawnParticle(Vec3 const& startPos, Vec3 const& velocity, float rotation, float rotationSpeed, float size, float lifetime, std::string const& textureName, Rgba8 const& color, float startAlpha, float endAlpha, float startAlphaTime, float endAlphaTime, float startScale, float endScale, float startScaleTime, float endScaleTime, float startSpeedMultiplier, float endSpeedMultiplier, float startSpeedTime, float endSpeedTime);
+	void SpawnParticle(Vec3 const& startPos, Vec3 const& velocity, float rotation, float rotationSpeed, float size, float lifetime, int spriteHandle, Rgba8 const& color, float startAlpha, float endAlpha, float startAlphaTime, float endAlphaTime, float startScale, float endScale, float startScaleTime, float endScaleTime, float startSpeedMultiplier, float endSpeedMultiplier, float startSpeedTime, float endSpeedTime);
 
 public:	
 	bool						m_isPaused											= false;
@@ -134,6 +143,7 @@ public:
 	std::vector<std::string> m_commandsQueue;
 
 	std::vector<Particle> m_particles;
+	ParticleRenderer* m_particleRenderer = nullptr;
 
 public:
 	static const inline EulerAngles FIXED_CAMERA_ANGLE = EulerAngles(90.f, 60.f, 0.f);
@@ -153,6 +163,7 @@ private:
 	void						RenderLobby											() const;
 	void						RenderGame											() const;
 	void						RenderPauseMenu										() const;
+	void						RenderUnits											() const;
 
 	void						EnterAttract										();
 	void						ExitAttract											();
@@ -177,5 +188,8 @@ private:
 
 	std::vector<Vertex_PCU>		m_gridStaticVerts;
 
+	// Visible units sorted by model, refilled every frame by RenderUnits
+	mutable std::vector<Unit const*> m_unitRenderList;
+
 	float						m_timeInState										= 0.f;
 };
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "Game/HexBitboard.hpp"
+
+#include <bitset>
+
+
+HexBitboard::HexBitboard(IntVec2 const& dimensions)
+	: m_dimensions(dimensions)
+	, m_rows(dimensions.y, 0)
+{
+	m_rowMask = (dimensions.x >= 64) ? ~0ull : ((1ull << dimensions.x) - 1ull);
+}
+
+bool HexBitboard::CanRepresent(IntVec2 const& dimensions)
+{
+	return dimensions.x > 0 && dimensions.x <= 64 && dimensions.y > 0;
+}
+
+void HexBitboard::ClearAllTiles()
+{
+	for (int rowIndex = 0; rowIndex < (int)m_rows.size(); rowIndex++)
+	{
+		m_rows[rowIndex] = 0;
+	}
+}
+
+void HexBitboard::SetTile(IntVec2 const& tileCoords, bool isSet)
+{
+	unsigned long long tileBit = 1ull << tileCoords.x;
+	if (isSet)
+	{
+		m_rows[tileCoords.y] |= tileBit;
+	}
+	else
+	{
+		m_rows[tileCoords.y] &= ~tileBit;
+	}
+}
+
+bool HexBitboard::IsTileSet(IntVec2 const& tileCoords) const
+{
+	return (m_rows[tileCoords.y] >> tileCoords.x) & 1ull;
+}
+
+bool HexBitboard::IsEmpty() const
+{
+	for (int rowIndex = 0; rowIndex < (int)m_rows.size(); rowIndex++)
+	{
+		if (m_rows[rowIndex])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int HexBitboard::GetNumSetTiles() const
+{
+	int numSetTiles = 0;
+	for (int rowIndex = 0; rowIndex < (int)m_rows.size(); rowIndex++)
+	{
+		numSetTiles += (int)std::bitset<64>(m_rows[rowIndex]).count();
+	}
+
+	return numSetTiles;
+}
+
+void HexBitboard::CopyFrom(HexBitboard const& other)
+{
+	m_dimensions = other.m_dimensions;
+	m_rowMask = other.m_rowMask;
+	m_rows.resize(other.m_rows.size());
+	for (int rowIndex = 0; rowIndex < (int)m_rows.size(); rowIndex++)
+	{
+		m_rows[rowIndex] = other.m_rows[rowIndex];
+	}
+}
+
+void HexBitboard::UnionWith(HexBitboard const& other)
+{
+	for (int rowIndex = 0; rowIndex < (int)m_rows.size(); rowIndex++)
+	{
+		m_rows[rowIndex] |= other.m_rows[rowIndex];
+	}
+}
+
+void HexBitboard::IntersectWith(HexBitboard const& other)
+{
+	for (int rowIndex = 0; rowIndex < (int)m_rows.size(); rowIndex++)
+	{
+		m_rows[rowIndex] &= other.m_rows[rowIndex];
+	}
+}
+
+void HexBitboard::Subtract(HexBitboard const& other)
+{
+	for (int rowIndex = 0; rowIndex < (int)m_rows.size(); rowIndex++)
+	{
+		m_rows[rowIndex] &= ~other.m_rows[rowIndex];
+	}
+}
+
+void HexBitboard::Dilate(HexBitboard& out_dilated) const
+{
+	out_dilated.m_dimensions = m_dimensions;
+	out_dilated.m_rowMask = m_rowMask;
+	out_dilated.m_rows.resize(m_rows.size());
+
+	// Neighbors of (x, y) are (x, y+1), (x+1, y), (x+1, y-1), (x, y-1), (x-1, y) and (x-1, y+1),
+	// so tile (x, y) is set if row y has x-1, x or x+1, row y-1 has x or x+1, or row y+1 has x-1 or x
+	int numRows = (int)m_rows.size();
+	for (int rowIndex = 0; rowIndex < numRows; rowIndex++)
+	{
+		unsigned long long row = m_rows[rowIndex];
+		unsigned long long dilatedRow = row | (row << 1) | (row >> 1);
+		if (rowIndex > 0)
+		{
+			unsigned long long rowBelow = m_rows[rowIndex - 1];
+			dilatedRow |= rowBelow | (rowBelow >> 1);
+		}
+		if (rowIndex < numRows - 1)
+		{
+			unsigned long long rowAbove = m_rows[rowIndex + 1];
+			dilatedRow |= rowAbove | (rowAbove << 1);
+		}
+		out_dilated.m_rows[rowIndex] = dilatedRow & m_rowMask;
+	}
+}
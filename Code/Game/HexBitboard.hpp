@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+
+
+// One bit per tile, one 64-bit word per row of the hex grid, bit x of word y standing for tile (x, y)
+// Only grids up to 64 tiles wide fit; callers should check CanRepresent and fall back to the queue based searches otherwise
+class HexBitboard
+{
+public:
+	HexBitboard() = default;
+	explicit HexBitboard(IntVec2 const& dimensions);
+	static bool CanRepresent(IntVec2 const& dimensions);
+
+	void ClearAllTiles();
+	void SetTile(IntVec2 const& tileCoords, bool isSet);
+	bool IsTileSet(IntVec2 const& tileCoords) const;
+	bool IsEmpty() const;
+	int GetNumSetTiles() const;
+
+	void CopyFrom(HexBitboard const& other);
+	void UnionWith(HexBitboard const& other);
+	void IntersectWith(HexBitboard const& other);
+	void Subtract(HexBitboard const& other);
+
+	// out_dilated = this plus every tile with a neighbor in this; out_dilated must not alias this
+	void Dilate(HexBitboard& out_dilated) const;
+
+public:
+	IntVec2 m_dimensions = IntVec2::ZERO;
+	unsigned long long m_rowMask = 0;
+	std::vector<unsigned long long> m_rows;
+};
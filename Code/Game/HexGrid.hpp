@@ -0,0 +1,384 @@
+#pragma once
+
+#include "Engine/Math/IntVec2.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------------
+// Axial offset that can live in constant expressions, which IntVec2 cannot
+struct HexOffset
+{
+public:
+	int x = 0;
+	int y = 0;
+};
+
+constexpr int NUM_HEX_DIRECTIONS = 6;
+
+// The six directions around a hex; every neighbor table, ring walk and flow field in the game uses this order
+constexpr HexOffset HEX_DIRECTIONS[NUM_HEX_DIRECTIONS] = { { 0, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, 0 }, { -1, 1 } };
+
+constexpr int GetAbsoluteValue(int value)
+{
+	return value < 0 ? -value : value;
+}
+
+constexpr int GetHexDistance(int deltaX, int deltaY)
+{
+	return (GetAbsoluteValue(deltaX) + GetAbsoluteValue(deltaX + deltaY) + GetAbsoluteValue(deltaY)) / 2;
+}
+
+inline int GetHexDistance(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB)
+{
+	return GetHexDistance(tileCoordsA.x - tileCoordsB.x, tileCoordsA.y - tileCoordsB.y);
+}
+
+inline IntVec2 GetHexNeighborCoords(IntVec2 const& tileCoords, int directionIndex)
+{
+	return IntVec2(tileCoords.x + HEX_DIRECTIONS[directionIndex].x, tileCoords.y + HEX_DIRECTIONS[directionIndex].y);
+}
+
+// Rounds fractional axial coordinates to the hex containing them by rounding in cube coordinates (x, y, -x - y)
+// and fixing up whichever component rounded furthest, so the three still sum to zero
+inline IntVec2 RoundToNearestHex(float axialX, float axialY)
+{
+	float axialZ = -axialX - axialY;
+	float roundedX = roundf(axialX);
+	float roundedY = roundf(axialY);
+	float roundedZ = roundf(axialZ);
+	float errorX = fabsf(roundedX - axialX);
+	float errorY = fabsf(roundedY - axialY);
+	float errorZ = fabsf(roundedZ - axialZ);
+	if (errorX > errorY && errorX > errorZ)
+	{
+		roundedX = -roundedY - roundedZ;
+	}
+	else if (errorY > errorZ)
+	{
+		roundedY = -roundedX - roundedZ;
+	}
+
+	return IntVec2((int)roundedX, (int)roundedY);
+}
+
+constexpr int GetNumHexesInRing(int radius)
+{
+	return radius == 0 ? 1 : NUM_HEX_DIRECTIONS * radius;
+}
+
+constexpr int GetNumHexesInDisc(int radius)
+{
+	return radius < 0 ? 0 : 1 + 3 * radius * (radius + 1);
+}
+
+//----------------------------------------------------------------------------------------------------------
+// Row-major parallelogram of axial coordinates sized at runtime, so tile index = y * width + x
+class DynamicHexLayout
+{
+public:
+	DynamicHexLayout() = default;
+	explicit DynamicHexLayout(IntVec2 const& dimensions) : m_dimensions(dimensions) {}
+
+	int GetWidth() const { return m_dimensions.x; }
+	int GetHeight() const { return m_dimensions.y; }
+	int GetNumTiles() const { return m_dimensions.x * m_dimensions.y; }
+	IntVec2 GetDimensions() const { return m_dimensions; }
+	bool IsInBounds(IntVec2 const& tileCoords) const { return tileCoords.x >= 0 && tileCoords.x < m_dimensions.x && tileCoords.y >= 0 && tileCoords.y < m_dimensions.y; }
+	int GetTileIndex(IntVec2 const& tileCoords) const { return tileCoords.y * m_dimensions.x + tileCoords.x; }
+	IntVec2 GetTileCoords(int tileIndex) const { return IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x); }
+
+public:
+	IntVec2 m_dimensions = IntVec2::ZERO;
+};
+
+// Same layout with the size baked in, so index math divides by a constant and whole-grid loops have a known trip count
+template <int WIDTH, int HEIGHT>
+class FixedHexLayout
+{
+public:
+	static constexpr int GetWidth() { return WIDTH; }
+	static constexpr int GetHeight() { return HEIGHT; }
+	static constexpr int GetNumTiles() { return WIDTH * HEIGHT; }
+	static IntVec2 GetDimensions() { return IntVec2(WIDTH, HEIGHT); }
+	static bool IsInBounds(IntVec2 const& tileCoords) { return tileCoords.x >= 0 && tileCoords.x < WIDTH && tileCoords.y >= 0 && tileCoords.y < HEIGHT; }
+	static int GetTileIndex(IntVec2 const& tileCoords) { return tileCoords.y * WIDTH + tileCoords.x; }
+	static IntVec2 GetTileCoords(int tileIndex) { return IntVec2(tileIndex % WIDTH, tileIndex / WIDTH); }
+};
+
+// The built-in skirmish maps
+typedef FixedHexLayout<12, 12> HexLayout12x12;
+
+// Dynamic grids live on the heap, fixed ones inline
+template <typename T, typename Layout>
+struct HexGridStorage
+{
+	typedef std::vector<T> Type;
+};
+
+template <typename T, int WIDTH, int HEIGHT>
+struct HexGridStorage<T, FixedHexLayout<WIDTH, HEIGHT>>
+{
+	typedef std::array<T, WIDTH * HEIGHT> Type;
+};
+
+//----------------------------------------------------------------------------------------------------------
+// What the ring, spiral and line ranges hand out; only in-bounds tiles are ever visited
+struct HexGridCell
+{
+public:
+	IntVec2 m_coords = IntVec2::ZERO;
+	int m_tileIndex = -1;
+};
+
+// Visits every in-bounds tile whose distance from the center is in [minRadius, maxRadius], nearest rings first
+template <typename Layout>
+class HexSpiralIterator
+{
+public:
+	HexSpiralIterator(Layout const& layout, IntVec2 const& centerCoords, int radius, int endRadius)
+		: m_layout(&layout)
+		, m_centerCoords(centerCoords)
+		, m_radius(radius)
+		, m_endRadius(endRadius)
+	{
+		StartRing();
+		SkipOutOfBounds();
+	}
+
+	HexGridCell operator*() const
+	{
+		HexGridCell cell;
+		cell.m_coords = m_coords;
+		cell.m_tileIndex = m_layout->GetTileIndex(m_coords);
+		return cell;
+	}
+
+	HexSpiralIterator& operator++()
+	{
+		Step();
+		SkipOutOfBounds();
+		return *this;
+	}
+
+	bool operator!=(HexSpiralIterator const& other) const
+	{
+		return m_radius != other.m_radius || m_numStepsInRing != other.m_numStepsInRing;
+	}
+
+private:
+	void StartRing()
+	{
+		m_numStepsInRing = 0;
+		m_coords = IntVec2(m_centerCoords.x + HEX_DIRECTIONS[4].x * m_radius, m_centerCoords.y + HEX_DIRECTIONS[4].y * m_radius);
+	}
+
+	void Step()
+	{
+		if (m_radius > 0)
+		{
+			m_coords = GetHexNeighborCoords(m_coords, m_numStepsInRing / m_radius);
+		}
+		m_numStepsInRing++;
+
+		if (m_numStepsInRing == GetNumHexesInRing(m_radius))
+		{
+			m_radius++;
+			StartRing();
+		}
+	}
+
+	void SkipOutOfBounds()
+	{
+		while (m_radius < m_endRadius && !m_layout->IsInBounds(m_coords))
+		{
+			Step();
+		}
+	}
+
+private:
+	Layout const* m_layout = nullptr;
+	IntVec2 m_centerCoords = IntVec2::ZERO;
+	IntVec2 m_coords = IntVec2::ZERO;
+	int m_radius = 0;
+	int m_endRadius = 0;
+	int m_numStepsInRing = 0;
+};
+
+template <typename Layout>
+class HexSpiralRange
+{
+public:
+	HexSpiralRange(Layout const& layout, IntVec2 const& centerCoords, int minRadius, int maxRadius)
+		: m_layout(&layout)
+		, m_centerCoords(centerCoords)
+		, m_minRadius(minRadius < 0 ? 0 : minRadius)
+		, m_endRadius(maxRadius + 1)
+	{
+		if (m_endRadius < m_minRadius)
+		{
+			m_endRadius = m_minRadius;
+		}
+	}
+
+	HexSpiralIterator<Layout> begin() const { return HexSpiralIterator<Layout>(*m_layout, m_centerCoords, m_minRadius, m_endRadius); }
+	HexSpiralIterator<Layout> end() const { return HexSpiralIterator<Layout>(*m_layout, m_centerCoords, m_endRadius, m_endRadius); }
+
+private:
+	Layout const* m_layout = nullptr;
+	IntVec2 m_centerCoords = IntVec2::ZERO;
+	int m_minRadius = 0;
+	int m_endRadius = 0;
+};
+
+// Visits the in-bounds tiles on the hex line between two tiles, both ends included
+// The segment between the two centers is sampled and each sample rounded to the nearest hex; both ends are nudged by the same tiny amount so samples landing exactly on an edge always pick the same side
+template <typename Layout>
+class HexLineIterator
+{
+public:
+	HexLineIterator(Layout const& layout, IntVec2 const& fromCoords, IntVec2 const& toCoords, int stepIndex)
+		: m_layout(&layout)
+		, m_fromCoords(fromCoords)
+		, m_toCoords(toCoords)
+		, m_distance(GetHexDistance(fromCoords, toCoords))
+		, m_stepIndex(stepIndex)
+	{
+		SkipOutOfBounds();
+	}
+
+	HexGridCell operator*() const
+	{
+		HexGridCell cell;
+		cell.m_coords = m_coords;
+		cell.m_tileIndex = m_layout->GetTileIndex(m_coords);
+		return cell;
+	}
+
+	HexLineIterator& operator++()
+	{
+		m_stepIndex++;
+		SkipOutOfBounds();
+		return *this;
+	}
+
+	bool operator!=(HexLineIterator const& other) const
+	{
+		return m_stepIndex != other.m_stepIndex;
+	}
+
+private:
+	IntVec2 GetSampleCoords(int stepIndex) const
+	{
+		float const nudgeX = 1e-4f;
+		float const nudgeY = 2e-4f;
+		float fraction = (m_distance == 0) ? 0.f : (float)stepIndex / (float)m_distance;
+		float sampleX = (float)m_fromCoords.x + nudgeX + (float)(m_toCoords.x - m_fromCoords.x) * fraction;
+		float sampleY = (float)m_fromCoords.y + nudgeY + (float)(m_toCoords.y - m_fromCoords.y) * fraction;
+		return RoundToNearestHex(sampleX, sampleY);
+	}
+
+	void SkipOutOfBounds()
+	{
+		for (; m_stepIndex <= m_distance; m_stepIndex++)
+		{
+			m_coords = GetSampleCoords(m_stepIndex);
+			if (m_layout->IsInBounds(m_coords))
+			{
+				return;
+			}
+		}
+	}
+
+private:
+	Layout const* m_layout = nullptr;
+	IntVec2 m_fromCoords = IntVec2::ZERO;
+	IntVec2 m_toCoords = IntVec2::ZERO;
+	IntVec2 m_coords = IntVec2::ZERO;
+	int m_distance = 0;
+	int m_stepIndex = 0;
+};
+
+template <typename Layout>
+class HexLineRange
+{
+public:
+	HexLineRange(Layout const& layout, IntVec2 const& fromCoords, IntVec2 const& toCoords)
+		: m_layout(&layout)
+		, m_fromCoords(fromCoords)
+		, m_toCoords(toCoords)
+	{
+	}
+
+	HexLineIterator<Layout> begin() const { return HexLineIterator<Layout>(*m_layout, m_fromCoords, m_toCoords, 0); }
+	HexLineIterator<Layout> end() const { return HexLineIterator<Layout>(*m_layout, m_fromCoords, m_toCoords, GetHexDistance(m_fromCoords, m_toCoords) + 1); }
+
+private:
+	Layout const* m_layout = nullptr;
+	IntVec2 m_fromCoords = IntVec2::ZERO;
+	IntVec2 m_toCoords = IntVec2::ZERO;
+};
+
+//----------------------------------------------------------------------------------------------------------
+// One value per tile of a hex map, laid out by Layout
+// m_values is public so kernels that only care about tile indexes can take the flat storage directly
+template <typename T, typename Layout = DynamicHexLayout>
+class HexGrid
+{
+public:
+	typedef typename HexGridStorage<T, Layout>::Type Storage;
+
+	HexGrid() = default;
+	explicit HexGrid(Layout const& layout, T const& initialValue = T())
+	{
+		Initialize(layout, initialValue);
+	}
+
+	void Initialize(Layout const& layout, T const& initialValue = T())
+	{
+		m_layout = layout;
+		ResizeStorage(m_values, m_layout.GetNumTiles());
+		Fill(initialValue);
+	}
+
+	void Fill(T const& value)
+	{
+		for (int tileIndex = 0; tileIndex < GetNumTiles(); tileIndex++)
+		{
+			m_values[tileIndex] = value;
+		}
+	}
+
+	int GetWidth() const { return m_layout.GetWidth(); }
+	int GetHeight() const { return m_layout.GetHeight(); }
+	int GetNumTiles() const { return (int)m_values.size(); }
+	IntVec2 GetDimensions() const { return m_layout.GetDimensions(); }
+	bool IsInBounds(IntVec2 const& tileCoords) const { return m_layout.IsInBounds(tileCoords); }
+	int GetTileIndex(IntVec2 const& tileCoords) const { return m_layout.GetTileIndex(tileCoords); }
+	IntVec2 GetTileCoords(int tileIndex) const { return m_layout.GetTileCoords(tileIndex); }
+
+	T& operator[](int tileIndex) { return m_values[tileIndex]; }
+	T const& operator[](int tileIndex) const { return m_values[tileIndex]; }
+	T& Get(IntVec2 const& tileCoords) { return m_values[GetTileIndex(tileCoords)]; }
+	T const& Get(IntVec2 const& tileCoords) const { return m_values[GetTileIndex(tileCoords)]; }
+
+	typename Storage::iterator begin() { return m_values.begin(); }
+	typename Storage::iterator end() { return m_values.end(); }
+	typename Storage::const_iterator begin() const { return m_values.begin(); }
+	typename Storage::const_iterator end() const { return m_values.end(); }
+
+	HexSpiralRange<Layout> GetRing(IntVec2 const& centerCoords, int radius) const { return HexSpiralRange<Layout>(m_layout, centerCoords, radius, radius); }
+	HexSpiralRange<Layout> GetSpiral(IntVec2 const& centerCoords, int minRadius, int maxRadius) const { return HexSpiralRange<Layout>(m_layout, centerCoords, minRadius, maxRadius); }
+	HexLineRange<Layout> GetLine(IntVec2 const& fromCoords, IntVec2 const& toCoords) const { return HexLineRange<Layout>(m_layout, fromCoords, toCoords); }
+
+private:
+	static void ResizeStorage(std::vector<T>& values, int numTiles) { values.resize(numTiles); }
+	template <size_t NUM_TILES>
+	static void ResizeStorage(std::array<T, NUM_TILES>& values, int numTiles) { (void)values; (void)numTiles; }
+
+public:
+	Layout m_layout;
+	Storage m_values = Storage();
+};
@@ -0,0 +1,43 @@
+#include "Game/HexRangeTable.hpp"
+
+#include "Game/HexGrid.hpp"
+
+
+void HexRangeTable::Build(int maxRadius)
+{
+	m_maxRadius = maxRadius;
+	m_offsets.clear();
+	m_firstOffsetIndexes.clear();
+	m_offsets.reserve(GetNumOffsetsInDisc(maxRadius));
+	m_firstOffsetIndexes.reserve(maxRadius + 2);
+
+	m_firstOffsetIndexes.push_back(0);
+	m_offsets.push_back(IntVec2::ZERO);
+
+	for (int radius = 1; radius <= maxRadius; radius++)
+	{
+		m_firstOffsetIndexes.push_back((int)m_offsets.size());
+
+		// Start radius steps out along direction 4 and walk each of the six sides in turn
+		IntVec2 ringCoords = IntVec2(HEX_DIRECTIONS[4].x * radius, HEX_DIRECTIONS[4].y * radius);
+		for (int sideIndex = 0; sideIndex < NUM_HEX_DIRECTIONS; sideIndex++)
+		{
+			for (int stepIndex = 0; stepIndex < radius; stepIndex++)
+			{
+				m_offsets.push_back(ringCoords);
+				ringCoords = GetHexNeighborCoords(ringCoords, sideIndex);
+			}
+		}
+	}
+	m_firstOffsetIndexes.push_back((int)m_offsets.size());
+}
+
+int HexRangeTable::GetMaxRadius() const
+{
+	return m_maxRadius;
+}
+
+int HexRangeTable::GetNumOffsetsInDisc(int radius) const
+{
+	return GetNumHexesInDisc(radius);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+
+
+// Axial offsets of every tile within m_maxRadius of a center, sorted ring by ring
+// The ring at distance r is m_offsets[m_firstOffsetIndexes[r]] up to (but not including) m_offsets[m_firstOffsetIndexes[r + 1]],
+// so any band of rings [minRadius, maxRadius] is one contiguous slice of m_offsets
+class HexRangeTable
+{
+public:
+	void Build(int maxRadius);
+	int GetMaxRadius() const;
+	int GetNumOffsetsInDisc(int radius) const;
+
+public:
+	int m_maxRadius = -1;
+	std::vector<IntVec2> m_offsets;
+	std::vector<int> m_firstOffsetIndexes;
+};
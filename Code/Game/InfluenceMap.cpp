@@ -0,0 +1,88 @@
+#include "Game/InfluenceMap.hpp"
+
+#include "Game/Map.hpp"
+#include "Game/Player.hpp"
+#include "Game/Unit.hpp"
+
+
+void InfluenceMap::Build(Map& map, Player const* player)
+{
+	m_player = player;
+
+	int numTiles = map.m_definition.m_dimensions.x * map.m_definition.m_dimensions.y;
+	m_threatCounts.assign(numTiles, 0);
+	m_threatDamage.assign(numTiles, 0);
+	m_maxThreatCount = 0;
+	if ((int)m_tileStamps.size() != numTiles)
+	{
+		m_tileStamps.assign(numTiles, 0);
+		m_currentStamp = 0;
+	}
+
+	m_unitTileIndexes.clear();
+	for (int unitIndex = 0; unitIndex < (int)player->m_units.size(); unitIndex++)
+	{
+		Unit const* unit = player->m_units[unitIndex];
+		if (!unit->m_isDead)
+		{
+			m_unitTileIndexes.push_back(map.GetTileIndexFromCoords(unit->m_tileCoords));
+		}
+	}
+	map.PopulateMultiSourceDistanceField(m_distanceToNearestUnit, m_unitTileIndexes);
+
+	// Each unit only touches the tiles around its own reachable set, so the whole pass stays independent of board size
+	for (int unitIndex = 0; unitIndex < (int)player->m_units.size(); unitIndex++)
+	{
+		Unit const* unit = player->m_units[unitIndex];
+		if (unit->m_isDead)
+		{
+			continue;
+		}
+
+		m_currentStamp++;
+		int minRange = unit->m_definition.m_attackRange.m_min;
+		int maxRange = unit->m_definition.m_attackRange.m_max;
+		int attackDamage = unit->m_definition.m_attackDamage;
+
+		AddThreatFromTile(map, unit->m_tileCoords, minRange, maxRange, attackDamage);
+		ReachableSet const& reachableSet = map.ComputeReachableSet(unit);
+		for (int reachableIndex = 0; reachableIndex < (int)reachableSet.m_tileIndexes.size(); reachableIndex++)
+		{
+			AddThreatFromTile(map, map.GetTileCoordsFromIndex(reachableSet.m_tileIndexes[reachableIndex]), minRange, maxRange, attackDamage);
+		}
+	}
+}
+
+bool InfluenceMap::IsBuilt() const
+{
+	return m_player != nullptr;
+}
+
+bool InfluenceMap::IsTileThreatened(int tileIndex) const
+{
+	return m_threatCounts[tileIndex] > 0;
+}
+
+void InfluenceMap::AddThreatFromTile(Map const& map, IntVec2 const& firingTileCoords, int minRange, int maxRange, int attackDamage)
+{
+	map.ForEachTileInRing(firingTileCoords, minRange, maxRange, [&](IntVec2 const& tileCoords, int tileIndex)
+	{
+		UNUSED(tileCoords);
+		if (m_tileStamps[tileIndex] == m_currentStamp)
+		{
+			return;
+		}
+
+		m_tileStamps[tileIndex] = m_currentStamp;
+		if (m_threatCounts[tileIndex] < 255)
+		{
+			m_threatCounts[tileIndex]++;
+		}
+		m_threatDamage[tileIndex] += attackDamage;
+
+		if (m_threatCounts[tileIndex] > m_maxThreatCount)
+		{
+			m_maxThreatCount = m_threatCounts[tileIndex];
+		}
+	});
+}
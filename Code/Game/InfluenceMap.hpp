@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Game/DistanceField.hpp"
+
+#include <vector>
+
+
+class Map;
+class Player;
+
+
+// Whole-board tactical fields for one player's units, rebuilt once per turn
+// m_distanceToNearestUnit comes from a single multi-source search seeded with every unit
+// m_threatCounts[i] is how many of the units could attack tile i next turn by moving within their movement range and then firing,
+// and m_threatDamage[i] sums their attack damage
+class InfluenceMap
+{
+public:
+	void Build(Map& map, Player const* player);
+	bool IsBuilt() const;
+	bool IsTileThreatened(int tileIndex) const;
+
+private:
+	void AddThreatFromTile(Map const& map, IntVec2 const& firingTileCoords, int minRange, int maxRange, int attackDamage);
+
+public:
+	Player const* m_player = nullptr;
+	DistanceField m_distanceToNearestUnit;
+	std::vector<unsigned char> m_threatCounts;
+	std::vector<int> m_threatDamage;
+	int m_maxThreatCount = 0;
+
+private:
+	// A unit adds to a tile at most once however many of its firing positions reach it, tracked by stamping tiles with the unit's pass number
+	std::vector<unsigned int> m_tileStamps;
+	unsigned int m_currentStamp = 0;
+	std::vector<int> m_unitTileIndexes;
+};
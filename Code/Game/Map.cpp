@@ -1,16 +1,20 @@
 #include "Game/Map.hpp"
 
 #include "Game/Game.hpp"
+#include "Game/InfluenceMap.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Player.hpp"
 #include "Game/Unit.hpp"
 #include "Game/UnitDefinition.hpp"
 
+#include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/Models/ModelLoader.hpp"
 #include "Engine/Networking/NetSystem.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
+#include <algorithm>
+#include <cfloat>
 #include <queue>
 
 
@@ -22,6 +26,9 @@ Map::~Map()
 	delete m_tilesVBO;
 	m_tilesVBO = nullptr;
 
+	delete m_mapQueryQueue;
+	m_mapQueryQueue = nullptr;
+
 	delete m_game->m_player1;
 	m_game->m_player1 = nullptr;
 
@@ -42,23 +49,50 @@ Map::Map(Game* game, MapDefinition const& definition)
 	m_mapVBO = g_renderer->CreateVertexBuffer(mapVertexes.size() * sizeof(Vertex_PCUTBN), VertexType::VERTEX_PCUTBN);
 	g_renderer->CopyCPUToGPU(mapVertexes.data(), mapVertexes.size() * sizeof(Vertex_PCUTBN), m_mapVBO);
 
-	std::vector<Vertex_PCU> tileVertexes;
+	DynamicHexLayout layout(m_definition.m_dimensions);
+	m_tiles.Initialize(layout);
+	m_isTileBlocked.Initialize(layout, 0);
+	m_tileMovementCosts.Initialize(layout, 0);
+	m_isTileOccupied.Initialize(layout, 0);
+	m_tileUnits.Initialize(layout, nullptr);
 	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
 	{
-		Vec2 tilePosition = GetTileWorldPositionFromIndex(tileIndex);
-
 		char tileSymbol = m_definition.m_tilesData[tileIndex];
 		TileDefinition* tileDef = TileDefinition::GetTileDefinitionFromSymbol(tileSymbol);
-
-		m_tiles.push_back(Tile(*tileDef));
-
-		if (IsPointInsideAABB2(tilePosition, AABB2(m_definition.m_bounds.m_mins.GetXY(), m_definition.m_bounds.m_maxs.GetXY())))
+		if (!tileDef)
 		{
-			m_tiles[tileIndex].AddVerts(tileVertexes, tilePosition.ToVec3());
+			ERROR_AND_DIE(Stringf("Map \"%s\" uses unknown tile symbol '%c'", m_definition.m_name.c_str(), tileSymbol));
 		}
+
+		m_tiles[tileIndex] = Tile(*tileDef);
+		m_isTileBlocked[tileIndex] = tileDef->m_isBlocked ? 1 : 0;
+		m_tileMovementCosts[tileIndex] = tileDef->m_isBlocked ? 0 : (unsigned char)tileDef->m_movementCost;
+	}
+	RebuildTilesVBO();
+
+	m_neighborTable.Build(m_definition.m_dimensions);
+	m_rangeTable.Build(UnitDefinition::GetMaxRange());
+	m_distanceFieldFrontier.Reserve(numTiles);
+	m_hasBitboards = HexBitboard::CanRepresent(m_definition.m_dimensions);
+	if (m_hasBitboards)
+	{
+		// Scratch bitboards are sized once here, so the reachability queries never allocate
+		m_occupiedBitboard = HexBitboard(m_definition.m_dimensions);
+		m_dilatedBitboard = HexBitboard(m_definition.m_dimensions);
+	}
+	RefreshMaxMovementCost();
+	m_pathSearchState.Reserve(numTiles);
+	m_reachableSet.m_distanceField = DistanceField(m_definition.m_dimensions);
+	m_debugDistanceField = DistanceField(m_definition.m_dimensions);
+	m_previewReachableSet.m_distanceField = DistanceField(m_definition.m_dimensions);
+
+
+	m_mapQueryQueue = new MapQueryQueue(g_gameConfigBlackboard.GetValue("mapQueryWorkerThreads", 1));
+
+	if (numTiles <= g_gameConfigBlackboard.GetValue("allPairsDistanceMaxTiles", 256))
+	{
+		m_allPairsDistanceTable.Build(m_neighborTable, m_isTileBlocked.m_values, m_tileMovementCosts.m_values, m_maxMovementCost);
 	}
-	m_tilesVBO = g_renderer->CreateVertexBuffer(tileVertexes.size() * sizeof(Vertex_PCU));
-	g_renderer->CopyCPUToGPU(tileVertexes.data(), tileVertexes.size() * sizeof(Vertex_PCU), m_tilesVBO);
 
 	// Initialize Players
 	if (m_game->m_gameType == GameType::LOCAL)
@@ -104,6 +138,7 @@ Map::Map(Game* game, MapDefinition const& definition)
 	}
 
 	m_game->m_player1->m_turnState = TurnState::NO_SELECTION;
+	RefreshInfluenceMaps();
 }
 
 void Map::LoadAssets()
@@ -159,30 +194,19 @@ void Map::Update()
 	m_game->m_playerPosition.y = GetClamped(m_game->m_playerPosition.y, m_definition.m_bounds.m_mins.y - m_game->m_playerPosition.z / TanDegrees(Game::FIXED_CAMERA_ANGLE.m_pitchDegrees), m_definition.m_bounds.m_maxs.y - m_game->m_playerPosition.z / TanDegrees(Game::FIXED_CAMERA_ANGLE.m_pitchDegrees));
 	m_game->m_playerPosition.z = GetClamped(m_game->m_playerPosition.z, CAMERA_MIN_ELEVATION, m_definition.m_bounds.m_maxs.z);
 
-	Player* const& player1 = m_game->m_player1;
-	Player* const& player2 = m_game->m_player2;
-	Unit* hoveredUnit = nullptr;
-	if (player1)
+	Player* currentPlayer = m_game->GetCurrentPlayer();
+	m_mapQueryQueue->DispatchCompletedQueries(m_boardVersion);
+	if (currentPlayer && currentPlayer->m_turnState == TurnState::UNIT_SELECTED_MOVE && currentPlayer->m_selectedUnit && !currentPlayer->m_selectedUnit->m_didMove)
 	{
-		for (int unitIndex = 0; unitIndex < (int)player1->m_units.size(); unitIndex++)
-		{
-			if (player1->m_units[unitIndex]->m_tileCoords == m_hoveredTile)
-			{
-				hoveredUnit = player1->m_units[unitIndex];
-				break;
-			}
-		}
+		UpdateMovePreviewQueries(currentPlayer->m_selectedUnit);
 	}
-	if (player2 && !hoveredUnit)
+
+	Player* const& player1 = m_game->m_player1;
+	Unit* hoveredUnit = GetUnitOnTile(m_hoveredTile);
+
+	if (hoveredUnit && !m_game->IsUnitVisible(hoveredUnit))
 	{
-		for (int unitIndex = 0; unitIndex < (int)player2->m_units.size(); unitIndex++)
-		{
-			if (player2->m_units[unitIndex]->m_tileCoords == m_hoveredTile)
-			{
-				hoveredUnit = player2->m_units[unitIndex];
-				break;
-			}
-		}
+		hoveredUnit = nullptr;
 	}
 
 	if (hoveredUnit)
@@ -245,113 +269,125 @@ void Map::Render() const
 		g_renderer->BindShader(nullptr);
 		g_renderer->DrawVertexBuffer(m_tilesVBO, (int)m_tilesVBO->m_size / (int)sizeof(Vertex_PCU));
 
-		Player* const& player1 = m_game->m_player1;
-		Player* const& player2 = m_game->m_player2;
-
-		std::vector<Vertex_PCU> tileHighlightVerts;
-		Player* currentPlayer = m_game->GetCurrentPlayer();
-		Player* waitingPlayer = m_game->GetWaitingPlayer();
-		if (currentPlayer && currentPlayer->m_turnState == TurnState::UNIT_SELECTED_MOVE)
-		{
-			Unit* selectedUnit = currentPlayer->m_selectedUnit;
-			if (selectedUnit && !selectedUnit->m_didMove)
-			{
-				for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); tileIndex++)
-				{
-					IntVec2 tileCoords = GetTileCoordsFromIndex(tileIndex);
-
-					if (GetHexTaxicabDistance(tileCoords, selectedUnit->m_tileCoords) > selectedUnit->m_definition.m_movementRange)
-					{
-						continue;
-					}
-
-					Vec3 tilePosition = GetTileWorldPositionFromIndex(tileIndex).ToVec3();
-					if (!IsPointInsideAABB2(tilePosition.GetXY(), AABB2(m_definition.m_bounds.m_mins.GetXY(), m_definition.m_bounds.m_maxs.GetXY())))
-					{
-						continue;
-					}
-					if (player1->GetUnitFromTileCoords(tileCoords) || player2->GetUnitFromTileCoords(tileCoords))
-					{
-						continue;
-					}
-
-					m_tiles[tileIndex].AddVertsForHighlight(tileHighlightVerts, tilePosition);
-				}
+		// Highlight geometry lives in the overlay's buffers and is only rebuilt by UpdateOverlay when what it shows changes
+		m_overlay.Render();
+	}
+	g_renderer->EndCamera(m_game->m_worldCamera);
+}
 
-				if (GetHexTaxicabDistance(m_hoveredTile, selectedUnit->m_tileCoords) <= selectedUnit->m_definition.m_movementRange)
-				{
-					std::vector<IntVec2> tilesPath;
-					GenerateHeatMapPath(tilesPath, m_hoveredTile, selectedUnit->m_tileCoords, selectedUnit->m_heatMap);
-					for (int tilePathIndex = 0; tilePathIndex < (int)tilesPath.size(); tilePathIndex++)
-					{
-						IntVec2 const& pathTileCoords = tilesPath[tilePathIndex];
-						int tileIndex = GetTileIndexFromCoords(pathTileCoords);
-						Vec2 tilePosition = GetTileWorldPositionFromCoordinates(pathTileCoords);
-						m_tiles[tileIndex].AddVertsForPathHighlight(tileHighlightVerts, tilePosition.ToVec3());
-					}
-				}
-			}
-		}
+void Map::UpdateOverlay()
+{
+	Player* currentPlayer = m_game->GetCurrentPlayer();
+	Player* waitingPlayer = m_game->GetWaitingPlayer();
+	bool isHoveredTileInMap = m_hoveredTile.x >= 0 && m_hoveredTile.x < m_definition.m_dimensions.x && m_hoveredTile.y >= 0 && m_hoveredTile.y < m_definition.m_dimensions.y;
+	int hoveredTileIndex = isHoveredTileInMap ? GetTileIndexFromCoords(m_hoveredTile) : -1;
 
-		std::vector<Vertex_PCU> tileHoverVertexes;
-		for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); tileIndex++)
+	MapOverlayKey moveRangeKey;
+	if (currentPlayer && currentPlayer->m_turnState == TurnState::UNIT_SELECTED_MOVE)
+	{
+		Unit* selectedUnit = currentPlayer->m_selectedUnit;
+		if (selectedUnit && !selectedUnit->m_didMove && m_previewReachableSet.m_unit == selectedUnit && m_previewReachableSet.m_sourceCoords == selectedUnit->m_tileCoords && m_previewReachableSet.m_boardVersion == m_boardVersion)
 		{
-			Vec3 tilePosition = GetTileWorldPositionFromIndex(tileIndex).ToVec3();
-			IntVec2 tileCoords = GetTileCoordsFromIndex(tileIndex);
-			if (currentPlayer && currentPlayer->m_turnState == TurnState::UNIT_SELECTED_ATTACK && waitingPlayer->GetUnitFromTileCoords(tileCoords))
-			{
-				m_tiles[tileIndex].AddVertsForAttackHighlight(tileHighlightVerts, tilePosition);
-			}
-			else
-			{
-				m_tiles[tileIndex].AddVertsForHover(tileHoverVertexes, tilePosition);
-			}
+			moveRangeKey.m_isShown = true;
+			moveRangeKey.m_unit = selectedUnit;
+			moveRangeKey.m_tileCoords = selectedUnit->m_tileCoords;
+			moveRangeKey.m_boardVersion = m_boardVersion;
+			moveRangeKey.m_numTiles = (int)m_previewReachableSet.m_tileIndexes.size();
 		}
-
-		Rgba8 hoverColor = Rgba8::LIME;
-		Unit* hoveredUnit = nullptr;
-		if (player1)
+	}
+	if (m_overlay.IsLayerDirty(MapOverlayLayer::MOVE_RANGE, moveRangeKey))
+	{
+		std::vector<HexOverlayInstance>& moveRangeInstances = m_overlay.BeginLayer(MapOverlayLayer::MOVE_RANGE, moveRangeKey);
+		if (moveRangeKey.m_isShown)
 		{
-			for (int unitIndex = 0; unitIndex < (int)player1->m_units.size(); unitIndex++)
+			for (int reachableIndex = 0; reachableIndex < (int)m_previewReachableSet.m_tileIndexes.size(); reachableIndex++)
 			{
-				if (player1->m_units[unitIndex]->m_tileCoords == m_hoveredTile)
+				int tileIndex = m_previewReachableSet.m_tileIndexes[reachableIndex];
+				Vec3 tilePosition = GetTileWorldPositionFromIndex(tileIndex).ToVec3();
+				if (m_isTileBlocked[tileIndex] || !IsPointInsideAABB2(tilePosition.GetXY(), AABB2(m_definition.m_bounds.m_mins.GetXY(), m_definition.m_bounds.m_maxs.GetXY())))
 				{
-					hoveredUnit = player1->m_units[unitIndex];
-					break;
+					continue;
 				}
+
+				moveRangeInstances.push_back(HexOverlayInstance(tilePosition, HexOverlayStyle::MOVE_RANGE));
 			}
 		}
-		if (player2 && !hoveredUnit)
+		m_overlay.EndLayer(MapOverlayLayer::MOVE_RANGE);
+	}
+
+	// The path comes back from a worker some frames after the goal changes, so its length is part of what the layer shows
+	MapOverlayKey pathPreviewKey;
+	if (moveRangeKey.m_isShown && isHoveredTileInMap && m_previewReachableSet.IsTileReachable(hoveredTileIndex) && m_previewPathGoalCoords == m_hoveredTile)
+	{
+		pathPreviewKey.m_isShown = true;
+		pathPreviewKey.m_unit = moveRangeKey.m_unit;
+		pathPreviewKey.m_tileCoords = m_previewPathGoalCoords;
+		pathPreviewKey.m_boardVersion = m_previewPathBoardVersion;
+		pathPreviewKey.m_numTiles = (int)m_previewPath.size();
+	}
+	if (m_overlay.IsLayerDirty(MapOverlayLayer::PATH_PREVIEW, pathPreviewKey))
+	{
+		std::vector<HexOverlayInstance>& pathPreviewInstances = m_overlay.BeginLayer(MapOverlayLayer::PATH_PREVIEW, pathPreviewKey);
+		if (pathPreviewKey.m_isShown)
 		{
-			for (int unitIndex = 0; unitIndex < (int)player2->m_units.size(); unitIndex++)
+			for (int tilePathIndex = 0; tilePathIndex < (int)m_previewPath.size(); tilePathIndex++)
 			{
-				if (player2->m_units[unitIndex]->m_tileCoords == m_hoveredTile)
+				IntVec2 const& pathTileCoords = m_previewPath[tilePathIndex];
+				if (!m_isTileBlocked[GetTileIndexFromCoords(pathTileCoords)])
 				{
-					hoveredUnit = player2->m_units[unitIndex];
-					break;
+					pathPreviewInstances.push_back(HexOverlayInstance(GetTileWorldPositionFromCoordinates(pathTileCoords).ToVec3(), HexOverlayStyle::PATH));
 				}
 			}
 		}
+		m_overlay.EndLayer(MapOverlayLayer::PATH_PREVIEW);
+	}
 
-		if (hoveredUnit)
+	// Only the hovered tile can carry a hover ring or an attack marker, so there is no need to walk every tile
+	MapOverlayKey attackTargetKey;
+	if (isHoveredTileInMap && currentPlayer && currentPlayer->m_turnState == TurnState::UNIT_SELECTED_ATTACK && currentPlayer->m_selectedUnit)
+	{
+		if (CanUnitAttackTile(currentPlayer->m_selectedUnit, m_hoveredTile) && waitingPlayer->GetUnitFromTileCoords(m_hoveredTile))
 		{
-			if (hoveredUnit->m_owner != m_game->GetCurrentPlayer())
-			{
-				hoverColor = Rgba8::RED;
-			}
-			else
-			{
-				hoverColor = Rgba8::BLUE;
-			}
+			attackTargetKey.m_isShown = true;
+			attackTargetKey.m_unit = currentPlayer->m_selectedUnit;
+			attackTargetKey.m_tileCoords = m_hoveredTile;
+			attackTargetKey.m_boardVersion = m_boardVersion;
 		}
+	}
+	if (m_overlay.IsLayerDirty(MapOverlayLayer::ATTACK_TARGET, attackTargetKey))
+	{
+		std::vector<HexOverlayInstance>& attackTargetInstances = m_overlay.BeginLayer(MapOverlayLayer::ATTACK_TARGET, attackTargetKey);
+		if (attackTargetKey.m_isShown)
+		{
+			attackTargetInstances.push_back(HexOverlayInstance(GetTileWorldPositionFromIndex(hoveredTileIndex).ToVec3(), HexOverlayStyle::ATTACK_TARGET));
+		}
+		m_overlay.EndLayer(MapOverlayLayer::ATTACK_TARGET);
+	}
 
-		g_renderer->SetModelConstants();
-		g_renderer->DrawVertexArray(tileHighlightVerts);
+	MapOverlayKey hoverKey;
+	hoverKey.m_color = Rgba8::LIME;
+	if (isHoveredTileInMap && !attackTargetKey.m_isShown)
+	{
+		hoverKey.m_isShown = true;
+		hoverKey.m_tileCoords = m_hoveredTile;
+		hoverKey.m_boardVersion = m_boardVersion;
 
-		g_renderer->SetModelConstants(Mat44::IDENTITY, hoverColor);
-		g_renderer->DrawVertexArray(tileHoverVertexes);
+		Unit* hoveredUnit = GetUnitOnTile(m_hoveredTile);
+		if (hoveredUnit && m_game->IsUnitVisible(hoveredUnit))
+		{
+			hoverKey.m_unit = hoveredUnit;
+			hoverKey.m_color = (hoveredUnit->m_owner != currentPlayer) ? Rgba8::RED : Rgba8::BLUE;
+		}
+	}
+	if (m_overlay.IsLayerDirty(MapOverlayLayer::HOVER, hoverKey))
+	{
+		std::vector<HexOverlayInstance>& hoverInstances = m_overlay.BeginLayer(MapOverlayLayer::HOVER, hoverKey);
+		if (hoverKey.m_isShown && !m_isTileBlocked[hoveredTileIndex])
+		{
+			hoverInstances.push_back(HexOverlayInstance(GetTileWorldPositionFromIndex(hoveredTileIndex).ToVec3(), HexOverlayStyle::HOVER));
+		}
+		m_overlay.EndLayer(MapOverlayLayer::HOVER);
 	}
-	g_renderer->EndCamera(m_game->m_worldCamera);
 }
 
 RaycastResult3D Map::RaycastCursorVsMap()
@@ -386,12 +422,12 @@ RaycastResult3D Map::RaycastCursorVsMap()
 
 IntVec2 Map::GetTileCoordsFromIndex(int tileIndex) const
 {
-	return IntVec2(tileIndex % m_definition.m_dimensions.x, tileIndex / m_definition.m_dimensions.y);
+	return m_tiles.GetTileCoords(tileIndex);
 }
 
 int Map::GetTileIndexFromCoords(IntVec2 const& tileCoords) const
 {
-	return m_definition.m_dimensions.x * tileCoords.y + tileCoords.x;
+	return m_tiles.GetTileIndex(tileCoords);
 }
 
 Vec2 Map::GetTileWorldPositionFromCoordinates(IntVec2 const& tileCoords) const
@@ -405,101 +441,143 @@ Vec2 Map::GetTileWorldPositionFromIndex(int tileIndex) const
 	return GetTileWorldPositionFromCoordinates(tileCoords);
 }
 
-int Map::GetHexTaxicabDistance(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB) const
+IntVec2 Map::GetTileCoordsFromWorldPosition(Vec2 const& worldPosition) const
 {
-	return int(fabsf((float)tileCoordsA.x - (float)tileCoordsB.x) + fabsf((float)tileCoordsA.x + (float)tileCoordsA.y - (float)tileCoordsB.x - (float)tileCoordsB.y) + fabsf((float)tileCoordsA.y - (float)tileCoordsB.y)) / 2;
+	float determinant = HEX_GRID_IBASIS.x * HEX_GRID_JBASIS.y - HEX_GRID_IBASIS.y * HEX_GRID_JBASIS.x;
+	float axialX = (worldPosition.x * HEX_GRID_JBASIS.y - worldPosition.y * HEX_GRID_JBASIS.x) / determinant;
+	float axialY = (HEX_GRID_IBASIS.x * worldPosition.y - HEX_GRID_IBASIS.y * worldPosition.x) / determinant;
+	return RoundToNearestHex(axialX, axialY);
 }
 
-void Map::GetAllNeighboringTileCoords(std::vector<IntVec2>& out_neighboringTiles, IntVec2 const& tileCoordsToFindNeighboringTilesFor) const
+bool Map::IsTilePickable(IntVec2 const& tileCoords) const
 {
-	IntVec2 const neighbor1(0, 1);
-	IntVec2 const neighbor2(1, 0);
-	IntVec2 const neighbor3(1, -1);
-	IntVec2 const neighbor4(0, -1);
-	IntVec2 const neighbor5(-1, 0);
-	IntVec2 const neighbor6(-1, 1);
+	if (!m_tiles.IsInBounds(tileCoords))
+	{
+		return false;
+	}
 
-	out_neighboringTiles.push_back(tileCoordsToFindNeighboringTilesFor + neighbor1);
-	out_neighboringTiles.push_back(tileCoordsToFindNeighboringTilesFor + neighbor2);
-	out_neighboringTiles.push_back(tileCoordsToFindNeighboringTilesFor + neighbor3);
-	out_neighboringTiles.push_back(tileCoordsToFindNeighboringTilesFor + neighbor4);
-	out_neighboringTiles.push_back(tileCoordsToFindNeighboringTilesFor + neighbor5);
-	out_neighboringTiles.push_back(tileCoordsToFindNeighboringTilesFor + neighbor6);
+	// Tiles whose centers fall outside the world bounds are cut off by the board's edge
+	Vec2 tilePosition = GetTileWorldPositionFromCoordinates(tileCoords);
+	return IsPointInsideAABB2(tilePosition, AABB2(m_definition.m_bounds.m_mins.GetXY(), m_definition.m_bounds.m_maxs.GetXY()));
 }
 
-void Map::GetAllNeighboringTileHeatValues(std::vector<float>& out_heatValues, IntVec2 const& tileCoordsToFindNeighboringHeatValuesFor, TileHeatMap const* heatMap) const
+IntVec2 Map::GetNearestPickableTileCoords(Vec2 const& worldPosition) const
 {
-	std::vector<IntVec2> neighboringTiles;
-	GetAllNeighboringTileCoords(neighboringTiles, tileCoordsToFindNeighboringHeatValuesFor);
-	for (int neighborIndex = 0; neighborIndex < (int)neighboringTiles.size(); neighborIndex++)
+	IntVec2 tileCoords = GetTileCoordsFromWorldPosition(worldPosition);
+	if (IsTilePickable(tileCoords))
 	{
-		IntVec2 const& neighborCoords = neighboringTiles[neighborIndex];
+		return tileCoords;
+	}
 
-		if (neighborCoords.x < 0 || neighborCoords.x >= m_definition.m_dimensions.x || neighborCoords.y < 0 || neighborCoords.y >= m_definition.m_dimensions.y)
+	// Off the board: start from the closest tile of the grid and widen ring by ring until pickable tiles turn up
+	// A pickable tile one ring further out can still be closer in world space, so that ring gets checked as well
+	IntVec2 const& dimensions = m_definition.m_dimensions;
+	IntVec2 clampedCoords((std::max)(0, (std::min)(tileCoords.x, dimensions.x - 1)), (std::max)(0, (std::min)(tileCoords.y, dimensions.y - 1)));
+	IntVec2 nearestTileCoords = IntVec2(-1, -1);
+	float nearestDistanceSquared = FLT_MAX;
+	int lastRadiusToSearch = dimensions.x + dimensions.y;
+	for (HexGridCell cell : m_tiles.GetSpiral(clampedCoords, 0, dimensions.x + dimensions.y))
+	{
+		int radius = GetHexDistance(cell.m_coords, clampedCoords);
+		if (radius > lastRadiusToSearch)
+		{
+			break;
+		}
+		if (!IsTilePickable(cell.m_coords))
 		{
 			continue;
 		}
 
-		out_heatValues.push_back(heatMap->GetValueAtTile(neighborCoords));
+		float distanceSquared = GetDistanceSquared2D(worldPosition, GetTileWorldPositionFromCoordinates(cell.m_coords));
+		if (distanceSquared < nearestDistanceSquared)
+		{
+			nearestDistanceSquared = distanceSquared;
+			nearestTileCoords = cell.m_coords;
+		}
+		if (lastRadiusToSearch > radius + 1)
+		{
+			lastRadiusToSearch = radius + 1;
+		}
 	}
+
+	return nearestTileCoords;
 }
 
-void Map::PopuplateDistanceField(std::vector<float>& out_distanceField, IntVec2 const& goalCoords, float specialValue) const
+int Map::GetHexTaxicabDistance(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB) const
 {
-	int numTiles = m_definition.m_dimensions.x * m_definition.m_dimensions.y;
-	out_distanceField.resize(numTiles);
-	for (int distanceIndex = 0; distanceIndex < numTiles; distanceIndex++)
+	return GetHexDistance(tileCoordsA, tileCoordsB);
+}
+
+Unit* Map::GetUnitOnTile(IntVec2 const& tileCoords) const
+{
+	if (!m_tileUnits.IsInBounds(tileCoords))
 	{
-		out_distanceField[distanceIndex] = specialValue;
+		return nullptr;
 	}
-	
-	std::queue<IntVec2> dirtyTileQueue;
-	dirtyTileQueue.push(goalCoords);
-	int goalIndex = GetTileIndexFromCoords(goalCoords);
-	out_distanceField[goalIndex] = 0.f;
 
-	while (!dirtyTileQueue.empty())
+	return m_tileUnits.Get(tileCoords);
+}
+
+void Map::PlaceUnitOnTile(Unit* unit, IntVec2 const& tileCoords)
+{
+	m_tileUnits.Get(tileCoords) = unit;
+	m_isTileOccupied.Get(tileCoords) = 1;
+	if (m_hasBitboards)
 	{
-		IntVec2 currentTileCoords = dirtyTileQueue.front();
-		dirtyTileQueue.pop();
-		int currentTileIndex = GetTileIndexFromCoords(currentTileCoords);
-		float currentHeatValue = out_distanceField[currentTileIndex];
-		std::vector<IntVec2> neighboringTileCoords;
-		GetAllNeighboringTileCoords(neighboringTileCoords, currentTileCoords);
+		m_occupiedBitboard.SetTile(tileCoords, true);
+	}
+}
 
-		for (int neighborIndex = 0; neighborIndex < (int)neighboringTileCoords.size(); neighborIndex++)
+void Map::RemoveUnitFromTile(Unit* unit, IntVec2 const& tileCoords)
+{
+	// A unit in the same group move may already have taken the tile over
+	if (m_tileUnits.Get(tileCoords) == unit)
+	{
+		m_tileUnits.Get(tileCoords) = nullptr;
+		m_isTileOccupied.Get(tileCoords) = 0;
+		if (m_hasBitboards)
 		{
-			IntVec2 const& neighborCoords = neighboringTileCoords[neighborIndex];
-			if (neighborCoords.x < 0 || neighborCoords.x >= m_definition.m_dimensions.x || neighborCoords.y < 0 || neighborCoords.y >= m_definition.m_dimensions.y)
-			{
-				continue;
-			}
+			m_occupiedBitboard.SetTile(tileCoords, false);
+		}
+	}
+}
 
-			int neighborTileIndex = GetTileIndexFromCoords(neighborCoords);
-			Tile const& neighborTile = m_tiles[neighborTileIndex];
+void Map::PopuplateDistanceField(DistanceField& out_distanceField, IntVec2 const& goalCoords) const
+{
+	// Plain BFS is exact while every open tile costs 1, and is cheaper than running the bucket queue
+	if (m_maxMovementCost == 1)
+	{
+		::PopulateDistanceField(out_distanceField, m_neighborTable, m_isTileBlocked.m_values, GetTileIndexFromCoords(goalCoords), m_distanceFieldFrontier);
+		return;
+	}
 
-			if (!neighborTile.m_definition.m_isBlocked && out_distanceField[neighborTileIndex] > currentHeatValue + 1.f)
-			{
-				out_distanceField[neighborTileIndex] = currentHeatValue + 1.f;
-				dirtyTileQueue.push(neighborCoords);
-			}
-		}
+	::PopulateWeightedDistanceField(out_distanceField, m_neighborTable, m_tileMovementCosts.m_values, GetTileIndexFromCoords(goalCoords), m_distanceFieldBucketQueue);
+}
+
+void Map::PopulateMultiSourceDistanceField(DistanceField& out_distanceField, std::vector<int> const& sourceTileIndexes) const
+{
+	if (m_maxMovementCost == 1)
+	{
+		::PopulateMultiSourceDistanceField(out_distanceField, m_neighborTable, m_isTileBlocked.m_values, sourceTileIndexes, m_distanceFieldFrontier);
+		return;
 	}
+
+	::PopulateWeightedMultiSourceDistanceField(out_distanceField, m_neighborTable, m_tileMovementCosts.m_values, sourceTileIndexes, m_distanceFieldBucketQueue);
 }
 
-void Map::DebugRenderDistanceField(TileHeatMap const* heatMap) const
+void Map::DebugRenderDistanceField(DistanceField const* distanceField) const
 {
-	float heatMapMaxValue = -FLT_MAX;
-	for (int heatMapIndex = 0; heatMapIndex < (int)heatMap->m_values.size(); heatMapIndex++)
+	float heatMapMaxValue = 0.f;
+	for (int heatMapIndex = 0; heatMapIndex < (int)distanceField->m_values.size(); heatMapIndex++)
 	{
-		if (heatMap->m_values[heatMapIndex] == SPECIAL_VALUE_FOR_HEATMAP)
+		if (!distanceField->IsReachable(heatMapIndex))
 		{
 			continue;
 		}
 
-		if (heatMap->m_values[heatMapIndex] > heatMapMaxValue)
+		if ((float)distanceField->m_values[heatMapIndex] > heatMapMaxValue)
 		{
-			heatMapMaxValue = heatMap->m_values[heatMapIndex];
+			heatMapMaxValue = (float)distanceField->m_values[heatMapIndex];
 		}
 	}
 
@@ -512,9 +590,9 @@ void Map::DebugRenderDistanceField(TileHeatMap const* heatMap) const
 		if (IsPointInsideAABB2(tilePosition, AABB2(m_definition.m_bounds.m_mins.GetXY(), m_definition.m_bounds.m_maxs.GetXY())))
 		{
 			Rgba8 tileColor = Rgba8::BLUE;
-			if (heatMap->m_values[tileIndex] != SPECIAL_VALUE_FOR_HEATMAP)
+			if (distanceField->IsReachable(tileIndex))
 			{
-				tileColor = Interpolate(Rgba8::WHITE, Rgba8::BLACK, heatMap->m_values[tileIndex] / heatMapMaxValue);
+				tileColor = Interpolate(Rgba8::WHITE, Rgba8::BLACK, heatMapMaxValue > 0.f ? (float)distanceField->m_values[tileIndex] / heatMapMaxValue : 0.f);
 			}
 
 			m_tiles[tileIndex].AddHeatVerts(tileVertexes, tilePosition.ToVec3(), tileColor);
@@ -532,78 +610,477 @@ void Map::DebugRenderDistanceField(TileHeatMap const* heatMap) const
 	g_renderer->DrawVertexArray(tileVertexes);
 }
 
-void Map::GenerateHeatMapPath(std::vector<Vec2>& out_positions, IntVec2 const& sourceCoords, IntVec2 const& destinationCoords, TileHeatMap const* heatMap) const
+void Map::DebugRenderInfluenceMap(InfluenceMap const* influenceMap) const
 {
-	IntVec2 currentTileCoords = sourceCoords;
-	out_positions.push_back(GetTileWorldPositionFromCoordinates(sourceCoords));
+	if (!influenceMap->IsBuilt() || influenceMap->m_maxThreatCount == 0)
+	{
+		return;
+	}
+
+	std::vector<Vertex_PCU> tileVertexes;
+	for (int tileIndex = 0; tileIndex < (int)influenceMap->m_threatCounts.size(); tileIndex++)
+	{
+		if (!influenceMap->IsTileThreatened(tileIndex))
+		{
+			continue;
+		}
+
+		Vec2 tilePosition = GetTileWorldPositionFromIndex(tileIndex);
+		if (IsPointInsideAABB2(tilePosition, AABB2(m_definition.m_bounds.m_mins.GetXY(), m_definition.m_bounds.m_maxs.GetXY())))
+		{
+			float threatFraction = (float)influenceMap->m_threatCounts[tileIndex] / (float)influenceMap->m_maxThreatCount;
+			Rgba8 tileColor = Interpolate(Rgba8(255, 255, 0, 80), Rgba8(255, 0, 0, 200), threatFraction);
+			m_tiles[tileIndex].AddHeatVerts(tileVertexes, tilePosition.ToVec3(), tileColor);
+		}
+	}
 
-	while (currentTileCoords != destinationCoords)
+	g_renderer->SetBlendMode(BlendMode::ALPHA);
+	g_renderer->SetDepthMode(DepthMode::DISABLED);
+	g_renderer->SetModelConstants();
+	g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_BACK);
+	g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
+	g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
+	g_renderer->BindShader(nullptr);
+	g_renderer->BindTexture(nullptr);
+	g_renderer->DrawVertexArray(tileVertexes);
+}
+
+void Map::RefreshInfluenceMaps()
+{
+	Player* players[2] = { m_game->m_player1, m_game->m_player2 };
+	for (int playerIndex = 0; playerIndex < 2; playerIndex++)
+	{
+		if (players[playerIndex])
+		{
+			players[playerIndex]->m_threatMap.Build(*this, players[playerIndex]);
+		}
+	}
+}
+
+void Map::PlanGroupMove(std::vector<std::vector<IntVec2>>& out_tileCoordsPaths, std::vector<Unit*> const& units, IntVec2 const& targetCoords)
+{
+	out_tileCoordsPaths.clear();
+	out_tileCoordsPaths.resize(units.size());
+	for (int unitIndex = 0; unitIndex < (int)units.size(); unitIndex++)
+	{
+		out_tileCoordsPaths[unitIndex].push_back(units[unitIndex]->m_tileCoords);
+	}
+
+	// Units outside the group stay put and block the field; units in it walk through each other and only need distinct destinations
+	m_groupIsTileOccupied = m_isTileOccupied.m_values;
+	m_groupMovementCosts = m_tileMovementCosts.m_values;
+	for (int unitIndex = 0; unitIndex < (int)units.size(); unitIndex++)
+	{
+		m_groupIsTileOccupied[GetTileIndexFromCoords(units[unitIndex]->m_tileCoords)] = 0;
+	}
+	for (int tileIndex = 0; tileIndex < (int)m_groupMovementCosts.size(); tileIndex++)
+	{
+		if (m_groupIsTileOccupied[tileIndex])
+		{
+			m_groupMovementCosts[tileIndex] = 0;
+		}
+	}
+	for (int unitIndex = 0; unitIndex < (int)units.size(); unitIndex++)
 	{
-		std::vector<IntVec2> neighboringTileCoords;
-		std::vector<float> neighboringTileHeatValues;
-		GetAllNeighboringTileCoords(neighboringTileCoords, currentTileCoords);
-		float minHeatValue = FLT_MAX;
-		IntVec2 minHeatTileCoords = currentTileCoords;
+		m_groupIsTileOccupied[GetTileIndexFromCoords(units[unitIndex]->m_tileCoords)] = 1;
+	}
 
-		for (int neighborIndex = 0; neighborIndex < (int)neighboringTileCoords.size(); neighborIndex++)
+	// The target area is the smallest disc around the target with a tile for every unit in the group
+	int targetRadius = 0;
+	while (m_rangeTable.GetNumOffsetsInDisc(targetRadius) < (int)units.size())
+	{
+		targetRadius++;
+	}
+	m_groupGoalTileIndexes.clear();
+	ForEachTileInRing(targetCoords, 0, targetRadius, [&](IntVec2 const& tileCoords, int tileIndex)
+	{
+		UNUSED(tileCoords);
+		if (m_groupMovementCosts[tileIndex] != 0)
 		{
-			IntVec2 const& neighborCoords = neighboringTileCoords[neighborIndex];
+			m_groupGoalTileIndexes.push_back(tileIndex);
+		}
+	});
+
+	// One field for the whole order; every unit reads its path off it instead of searching from its own tile
+	PopulateWeightedMultiSourceFlowField(m_groupFlowField, m_neighborTable, m_groupMovementCosts, m_groupGoalTileIndexes.data(), (int)m_groupGoalTileIndexes.size(), m_distanceFieldBucketQueue);
+
+	// Units closest to the target pick first, with ties going to the earlier unit in the group, so every peer resolves
+	// conflicts the same way; each unit takes the furthest unclaimed tile along its descent that its movement range allows
+	std::vector<int> unitOrder;
+	for (int unitIndex = 0; unitIndex < (int)units.size(); unitIndex++)
+	{
+		unitOrder.push_back(unitIndex);
+	}
+	std::stable_sort(unitOrder.begin(), unitOrder.end(), [&](int unitIndexA, int unitIndexB)
+	{
+		return m_groupFlowField.GetValueAtTile(units[unitIndexA]->m_tileCoords) < m_groupFlowField.GetValueAtTile(units[unitIndexB]->m_tileCoords);
+	});
 
-			if (neighborCoords.x < 0 || neighborCoords.x >= m_definition.m_dimensions.x || neighborCoords.y < 0 || neighborCoords.y >= m_definition.m_dimensions.y)
+	std::vector<int> descentTileIndexes;
+	for (int orderIndex = 0; orderIndex < (int)unitOrder.size(); orderIndex++)
+	{
+		Unit const* unit = units[unitOrder[orderIndex]];
+		int currentTileIndex = GetTileIndexFromCoords(unit->m_tileCoords);
+		int costFromStart = 0;
+		descentTileIndexes.clear();
+		descentTileIndexes.push_back(currentTileIndex);
+		m_groupIsTileOccupied[currentTileIndex] = 0;
+
+		while (m_groupFlowField.m_values[currentTileIndex] != 0)
+		{
+			unsigned short minFlowValue = m_groupFlowField.m_values[currentTileIndex];
+			int minFlowTileIndex = currentTileIndex;
+			for (int neighborIndex = m_neighborTable.m_firstNeighborIndexes[currentTileIndex]; neighborIndex < m_neighborTable.m_firstNeighborIndexes[currentTileIndex + 1]; neighborIndex++)
 			{
-				continue;
+				int neighborTileIndex = m_neighborTable.m_neighborTileIndexes[neighborIndex];
+				if (m_groupFlowField.m_values[neighborTileIndex] < minFlowValue)
+				{
+					minFlowValue = m_groupFlowField.m_values[neighborTileIndex];
+					minFlowTileIndex = neighborTileIndex;
+				}
 			}
 
-			float heatValue = heatMap->GetValueAtTile(neighborCoords);
-			if (heatValue < minHeatValue)
+			if (minFlowTileIndex == currentTileIndex || costFromStart + m_groupMovementCosts[minFlowTileIndex] > unit->m_definition.m_movementRange)
 			{
-				minHeatValue = heatValue;
-				minHeatTileCoords = neighborCoords;
+				break;
 			}
+
+			costFromStart += m_groupMovementCosts[minFlowTileIndex];
+			currentTileIndex = minFlowTileIndex;
+			descentTileIndexes.push_back(currentTileIndex);
 		}
-		currentTileCoords = minHeatTileCoords;
-		out_positions.push_back(GetTileWorldPositionFromCoordinates(currentTileCoords));
-	}
 
-	//out_positions.push_back(GetTileWorldPositionFromCoordinates(destinationCoords));
-	std::reverse(std::begin(out_positions), std::end(out_positions));
+		int destinationPathIndex = (int)descentTileIndexes.size() - 1;
+		while (destinationPathIndex > 0 && m_groupIsTileOccupied[descentTileIndexes[destinationPathIndex]])
+		{
+			destinationPathIndex--;
+		}
+
+		m_groupIsTileOccupied[descentTileIndexes[destinationPathIndex]] = 1;
+		std::vector<IntVec2>& tileCoordsPath = out_tileCoordsPaths[unitOrder[orderIndex]];
+		for (int pathIndex = 1; pathIndex <= destinationPathIndex; pathIndex++)
+		{
+			tileCoordsPath.push_back(GetTileCoordsFromIndex(descentTileIndexes[pathIndex]));
+		}
+	}
 }
 
-void Map::GenerateHeatMapPath(std::vector<IntVec2>& out_tileCoordsPath, IntVec2 const& sourceCoords, IntVec2 const& destinationCoords, TileHeatMap const* heatMap) const
+ReachableSet const& Map::ComputeReachableSet(Unit const* unit)
 {
-	IntVec2 currentTileCoords = sourceCoords;
-	out_tileCoordsPath.push_back(sourceCoords);
-
-	while (currentTileCoords != destinationCoords)
+	if (m_reachableSet.m_unit == unit && m_reachableSet.m_sourceCoords == unit->m_tileCoords && m_reachableSet.m_movementRange == unit->m_definition.m_movementRange && m_reachableSet.m_boardVersion == m_boardVersion)
 	{
-		std::vector<IntVec2> neighboringTileCoords;
-		std::vector<float> neighboringTileHeatValues;
-		GetAllNeighboringTileCoords(neighboringTileCoords, currentTileCoords);
-		float minHeatValue = heatMap->GetValueAtTile(currentTileCoords);
-		IntVec2 minHeatTileCoords = currentTileCoords;
+		return m_reachableSet;
+	}
 
-		for (int neighborIndex = 0; neighborIndex < (int)neighboringTileCoords.size(); neighborIndex++)
-		{
-			IntVec2 const& neighborCoords = neighboringTileCoords[neighborIndex];
+	m_reachableSet.Reset();
+	m_reachableSet.m_unit = unit;
+	m_reachableSet.m_sourceCoords = unit->m_tileCoords;
+	m_reachableSet.m_movementRange = unit->m_definition.m_movementRange;
+	m_reachableSet.m_boardVersion = m_boardVersion;
+
+	std::vector<unsigned short>& distances = m_reachableSet.m_distanceField.m_values;
+	int sourceTileIndex = GetTileIndexFromCoords(unit->m_tileCoords);
+	distances[sourceTileIndex] = 0;
+	m_reachableSet.m_visitedTileIndexes.push_back(sourceTileIndex);
 
-			if (neighborCoords.x < 0 || neighborCoords.x >= m_definition.m_dimensions.x || neighborCoords.y < 0 || neighborCoords.y >= m_definition.m_dimensions.y)
+	// Every step costs at least 1, so a move within range never strays further than the range; with no other unit that close
+	// nothing can get in the way, and the terrain costs in the table are the answer
+	if (m_allPairsDistanceTable.IsBuilt() && !IsAnyOtherUnitWithinDistance(unit, m_reachableSet.m_movementRange))
+	{
+		ForEachTileInRing(unit->m_tileCoords, 1, m_reachableSet.m_movementRange, [&](IntVec2 const& tileCoords, int tileIndex)
+		{
+			UNUSED(tileCoords);
+			int distance = m_allPairsDistanceTable.GetDistance(sourceTileIndex, tileIndex);
+			if (distance <= m_reachableSet.m_movementRange)
 			{
-				continue;
+				distances[tileIndex] = (unsigned short)distance;
+				m_reachableSet.m_visitedTileIndexes.push_back(tileIndex);
+				m_reachableSet.m_tileIndexes.push_back(tileIndex);
 			}
+		});
+		std::stable_sort(m_reachableSet.m_tileIndexes.begin(), m_reachableSet.m_tileIndexes.end(), [&distances](int tileIndexA, int tileIndexB)
+		{
+			return distances[tileIndexA] < distances[tileIndexB];
+		});
+
+		return m_reachableSet;
+	}
 
-			float heatValue = heatMap->GetValueAtTile(neighborCoords);
-			if (heatValue < minHeatValue)
+	HexBitboard reachableTiles;
+	if (ComputeReachableBitboard(reachableTiles, unit->m_tileCoords, m_reachableSet.m_movementRange))
+	{
+		// Tiles that first show up in layer k cost exactly k to reach
+		for (int layerIndex = 1; layerIndex <= m_reachableSet.m_movementRange; layerIndex++)
+		{
+			HexBitboard const& layer = m_reachableLayers[layerIndex];
+			HexBitboard const& previousLayer = m_reachableLayers[layerIndex - 1];
+			for (int rowIndex = 0; rowIndex < (int)layer.m_rows.size(); rowIndex++)
 			{
-				minHeatValue = heatValue;
-				minHeatTileCoords = neighborCoords;
+				unsigned long long newTilesInRow = layer.m_rows[rowIndex] & ~previousLayer.m_rows[rowIndex];
+				for (int columnIndex = 0; newTilesInRow != 0; columnIndex++, newTilesInRow >>= 1)
+				{
+					if (newTilesInRow & 1ull)
+					{
+						int tileIndex = GetTileIndexFromCoords(IntVec2(columnIndex, rowIndex));
+						distances[tileIndex] = (unsigned short)layerIndex;
+						m_reachableSet.m_visitedTileIndexes.push_back(tileIndex);
+						m_reachableSet.m_tileIndexes.push_back(tileIndex);
+					}
+				}
 			}
 		}
-		currentTileCoords = minHeatTileCoords;
-		out_tileCoordsPath.push_back(currentTileCoords);
+
+		return m_reachableSet;
+	}
+
+	PopulateReachableSet(m_reachableSet, m_neighborTable, m_tileMovementCosts.m_values, m_isTileOccupied.m_values, sourceTileIndex, m_distanceFieldBucketQueue);
+
+	return m_reachableSet;
+}
+
+bool Map::ComputeReachableBitboard(HexBitboard& out_reachableTiles, IntVec2 const& sourceCoords, int movementRange) const
+{
+	if (!m_hasBitboards)
+	{
+		return false;
+	}
+
+	while ((int)m_reachableLayers.size() < movementRange + 1)
+	{
+		m_reachableLayers.push_back(HexBitboard(m_definition.m_dimensions));
+	}
+
+	// Layer k holds every tile reachable for a total cost of at most k: a tile costing c joins layer k
+	// when it neighbors a tile of layer k - c, so each layer is a few dilations and masks of earlier layers
+	HexBitboard& sourceLayer = m_reachableLayers[0];
+	sourceLayer.ClearAllTiles();
+	sourceLayer.SetTile(sourceCoords, true);
+
+	for (int layerIndex = 1; layerIndex <= movementRange; layerIndex++)
+	{
+		HexBitboard& layer = m_reachableLayers[layerIndex];
+		layer.CopyFrom(m_reachableLayers[layerIndex - 1]);
+
+		for (int movementCost = 1; movementCost <= m_maxMovementCost && movementCost <= layerIndex; movementCost++)
+		{
+			m_reachableLayers[layerIndex - movementCost].Dilate(m_dilatedBitboard);
+			m_dilatedBitboard.IntersectWith(m_movementCostBitboards[movementCost]);
+			m_dilatedBitboard.Subtract(m_occupiedBitboard);
+			layer.UnionWith(m_dilatedBitboard);
+		}
+	}
+
+	out_reachableTiles.CopyFrom(m_reachableLayers[movementRange]);
+	return true;
+}
+
+bool Map::HasLineOfSight(IntVec2 const& fromCoords, IntVec2 const& toCoords) const
+{
+	if (GetHexDistance(fromCoords, toCoords) <= 1)
+	{
+		return true;
+	}
+
+	// The endpoints never block; every tile strictly between them is at a distance from fromCoords in (0, distance)
+	for (HexGridCell cell : m_isTileBlocked.GetLine(fromCoords, toCoords))
+	{
+		if (cell.m_coords == fromCoords || cell.m_coords == toCoords)
+		{
+			continue;
+		}
+
+		if (m_isTileBlocked[cell.m_tileIndex])
+		{
+			return false;
+		}
 	}
 
-	//out_tileCoordsPath.push_back(destinationCoords);
-	std::reverse(std::begin(out_tileCoordsPath), std::end(out_tileCoordsPath));
+	return true;
+}
+
+void Map::ComputeVisibleTiles(std::vector<int>& out_visibleTileIndexes, IntVec2 const& viewerCoords, int sightRange) const
+{
+	out_visibleTileIndexes.clear();
+	ForEachTileInRing(viewerCoords, 0, sightRange, [&](IntVec2 const& tileCoords, int tileIndex)
+	{
+		if (HasLineOfSight(viewerCoords, tileCoords))
+		{
+			out_visibleTileIndexes.push_back(tileIndex);
+		}
+	});
+}
+
+void Map::RefreshUnitVisibility(Unit const* unit)
+{
+	std::vector<int> visibleTileIndexes;
+	ComputeVisibleTiles(visibleTileIndexes, unit->m_tileCoords, unit->m_definition.m_sightRange);
+	unit->m_owner->m_visibilityMap.SetUnitVisibleTiles(unit, visibleTileIndexes);
+}
+
+bool Map::CanUnitAttackTile(Unit const* attackingUnit, IntVec2 const& targetCoords) const
+{
+	int attackDistance = GetHexTaxicabDistance(attackingUnit->m_tileCoords, targetCoords);
+	if (attackDistance < attackingUnit->m_definition.m_attackRange.m_min || attackDistance > attackingUnit->m_definition.m_attackRange.m_max)
+	{
+		return false;
+	}
+
+	if (!attackingUnit->m_owner->IsTileVisible(targetCoords))
+	{
+		return false;
+	}
+
+	// Artillery fires indirectly at anything its side has spotted, everything else needs a clear line to the target
+	if (attackingUnit->m_definition.m_type == UnitType::ARTILLERY)
+	{
+		return true;
+	}
+
+	return HasLineOfSight(attackingUnit->m_tileCoords, targetCoords);
+}
+
+bool Map::FindPath(std::vector<IntVec2>& out_tileCoordsPath, IntVec2 const& startCoords, IntVec2 const& goalCoords, int maxCost) const
+{
+	int startTileIndex = GetTileIndexFromCoords(startCoords);
+	int goalTileIndex = GetTileIndexFromCoords(goalCoords);
+
+	// Units only ever make a route dearer, so a goal the terrain alone puts out of reach is out of reach
+	if (m_allPairsDistanceTable.IsBuilt() && m_allPairsDistanceTable.GetDistance(startTileIndex, goalTileIndex) > maxCost)
+	{
+		return false;
+	}
+
+	// The start tile holds the moving unit, which is occupied like every other unit's tile but never re-entered
+	return FindHexPath(out_tileCoordsPath, m_neighborTable, m_tileMovementCosts.m_values, m_isTileOccupied.m_values, m_pathSearchState, startCoords, goalCoords, maxCost);
+}
+
+bool Map::IsAnyOtherUnitWithinDistance(Unit const* unit, int distance) const
+{
+	bool isAnyOtherUnitWithinDistance = false;
+	ForEachTileInRing(unit->m_tileCoords, 1, distance, [&](IntVec2 const& tileCoords, int tileIndex)
+	{
+		UNUSED(tileCoords);
+		if (m_tileUnits[tileIndex] && m_tileUnits[tileIndex] != unit)
+		{
+			isAnyOtherUnitWithinDistance = true;
+		}
+	});
+
+	return isAnyOtherUnitWithinDistance;
+}
+
+std::shared_ptr<MapQuerySnapshot const> Map::GetQuerySnapshot()
+{
+	if (m_querySnapshot && m_querySnapshot->m_boardVersion == m_boardVersion)
+	{
+		return m_querySnapshot;
+	}
+
+	// Queries still running hold on to the snapshot they were given, so a new board version always gets a fresh one, which copies
+	// the occupancy and reuses the previous snapshot's terrain costs, since terrain never changes during a game
+	std::shared_ptr<MapQuerySnapshot> snapshot = std::make_shared<MapQuerySnapshot>();
+	snapshot->m_boardVersion = m_boardVersion;
+	snapshot->m_neighborTable = &m_neighborTable;
+	if (m_querySnapshot)
+	{
+		snapshot->m_tileMovementCosts = m_querySnapshot->m_tileMovementCosts;
+	}
+	else
+	{
+		snapshot->m_tileMovementCosts = std::make_shared<std::vector<unsigned char> const>(m_tileMovementCosts.m_values);
+	}
+	snapshot->m_maxMovementCost = m_maxMovementCost;
+	snapshot->m_isTileOccupied = m_isTileOccupied.m_values;
+
+	m_querySnapshot = snapshot;
+	return m_querySnapshot;
+}
+
+void Map::UpdateMovePreviewQueries(Unit const* selectedUnit)
+{
+	bool isReachableSetCurrent = m_previewReachableSet.m_unit == selectedUnit && m_previewReachableSet.m_sourceCoords == selectedUnit->m_tileCoords && m_previewReachableSet.m_boardVersion == m_boardVersion;
+	if (!isReachableSetCurrent && !m_mapQueryQueue->IsQueryPending(m_previewReachableSetTicket))
+	{
+		m_previewReachableSetTicket = m_mapQueryQueue->SubmitReachableSetQuery(GetQuerySnapshot(), selectedUnit, selectedUnit->m_tileCoords, selectedUnit->m_definition.m_movementRange, [this](MapQueryResult& result)
+		{
+			m_previewReachableSet.CopyReachableTiles(result.m_reachableSet, result.m_reachableTileCosts);
+		});
+	}
+
+	// A new hovered tile or board version makes the path in flight useless, so it is cancelled rather than waited for
+	if (m_previewPathGoalCoords == m_hoveredTile && m_previewPathBoardVersion == m_boardVersion)
+	{
+		return;
+	}
+
+	m_mapQueryQueue->CancelQuery(m_previewPathTicket);
+	m_previewPathTicket = -1;
+	m_previewPath.clear();
+	m_previewPathGoalCoords = m_hoveredTile;
+	m_previewPathBoardVersion = m_boardVersion;
+
+	bool isHoveredTileInMap = m_hoveredTile.x >= 0 && m_hoveredTile.x < m_definition.m_dimensions.x && m_hoveredTile.y >= 0 && m_hoveredTile.y < m_definition.m_dimensions.y;
+	if (!isHoveredTileInMap || m_hoveredTile == selectedUnit->m_tileCoords)
+	{
+		return;
+	}
+
+	m_previewPathTicket = m_mapQueryQueue->SubmitPathQuery(GetQuerySnapshot(), selectedUnit->m_tileCoords, m_hoveredTile, selectedUnit->m_definition.m_movementRange, [this](MapQueryResult& result)
+	{
+		if (result.m_goalCoords == m_hoveredTile && result.m_goalCoords == m_previewPathGoalCoords)
+		{
+			m_previewPath = std::move(result.m_tileCoordsPath);
+		}
+	});
+}
+
+void Map::NotifyBoardChanged()
+{
+	m_boardVersion++;
+}
+
+void Map::RefreshMaxMovementCost()
+{
+	m_maxMovementCost = 1;
+	for (int tileIndex = 0; tileIndex < m_tileMovementCosts.GetNumTiles(); tileIndex++)
+	{
+		if (m_tileMovementCosts[tileIndex] > m_maxMovementCost)
+		{
+			m_maxMovementCost = m_tileMovementCosts[tileIndex];
+		}
+	}
+
+	m_distanceFieldBucketQueue.Reserve(m_tileMovementCosts.GetNumTiles(), m_maxMovementCost);
+
+	if (m_hasBitboards)
+	{
+		m_movementCostBitboards.resize(m_maxMovementCost + 1);
+		for (int movementCost = 0; movementCost <= m_maxMovementCost; movementCost++)
+		{
+			m_movementCostBitboards[movementCost] = HexBitboard(m_definition.m_dimensions);
+		}
+		for (int tileIndex = 0; tileIndex < m_tileMovementCosts.GetNumTiles(); tileIndex++)
+		{
+			m_movementCostBitboards[m_tileMovementCosts[tileIndex]].SetTile(GetTileCoordsFromIndex(tileIndex), true);
+		}
+	}
+}
+
+void Map::RebuildTilesVBO()
+{
+	std::vector<Vertex_PCU> tileVertexes;
+	for (int tileIndex = 0; tileIndex < m_tiles.GetNumTiles(); tileIndex++)
+	{
+		Vec2 tilePosition = GetTileWorldPositionFromIndex(tileIndex);
+		if (IsPointInsideAABB2(tilePosition, AABB2(m_definition.m_bounds.m_mins.GetXY(), m_definition.m_bounds.m_maxs.GetXY())))
+		{
+			m_tiles[tileIndex].AddVerts(tileVertexes, tilePosition.ToVec3());
+		}
+	}
+
+	delete m_tilesVBO;
+	m_tilesVBO = g_renderer->CreateVertexBuffer(tileVertexes.size() * sizeof(Vertex_PCU));
+	g_renderer->CopyCPUToGPU(tileVertexes.data(), tileVertexes.size() * sizeof(Vertex_PCU), m_tilesVBO);
 }
 
 bool IsPointInsideHex(Vec2 const& referencePoint, Vec2 const& hexCenter, float hexRadius)
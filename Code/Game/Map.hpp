@@ -1,9 +1,18 @@
 #pragma once
 
+#include "Game/AllPairsDistanceTable.hpp"
+#include "Game/CursorPicker.hpp"
+#include "Game/DistanceField.hpp"
+#include "Game/HexBitboard.hpp"
+#include "Game/HexGrid.hpp"
+#include "Game/HexRangeTable.hpp"
 #include "Game/MapDefinition.hpp"
+#include "Game/MapOverlay.hpp"
+#include "Game/MapQueryQueue.hpp"
+#include "Game/PathSearchState.hpp"
+#include "Game/ReachableSet.hpp"
 #include "Game/Tile.hpp"
 
-#include "Engine/Core/HeatMaps/TileHeatMap.hpp"
 #include "Engine/Core/Models/Material.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/RaycastUtils.hpp"
@@ -12,6 +21,7 @@
 
 
 class Game;
+class InfluenceMap;
 class Unit;
 
 
@@ -28,41 +38,147 @@ public:
 	void Update();
 	void Render() const;
 
+	// Call after the players have updated the hovered tile and selection for the frame
+	void UpdateOverlay();
+
 	RaycastResult3D RaycastCursorVsMap();
 
 	IntVec2 GetTileCoordsFromIndex(int tileIndex) const;
 	int GetTileIndexFromCoords(IntVec2 const& tileCoords) const;
 	Vec2 GetTileWorldPositionFromCoordinates(IntVec2 const& tileCoords) const;
 	Vec2 GetTileWorldPositionFromIndex(int tileIndex) const;
-	int GetHexTaxicabDistance(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB) const;
 
-	void GetAllNeighboringTileCoords(std::vector<IntVec2>& out_neighboringTiles, IntVec2 const& tileCoordsToFindNeighboringTilesFor) const;
-	void GetAllNeighboringTileHeatValues(std::vector<float>& out_heatValues, IntVec2 const& tileCoordsToFindNeighboringHeatValuesFor, TileHeatMap const* heatMap) const;
+	// Inverse of GRID_TO_WORLD_TRANSFORM rounded to the hex under worldPosition, which may lie outside the map
+	IntVec2 GetTileCoordsFromWorldPosition(Vec2 const& worldPosition) const;
+	bool IsTilePickable(IntVec2 const& tileCoords) const;
+	IntVec2 GetNearestPickableTileCoords(Vec2 const& worldPosition) const;
+	int GetHexTaxicabDistance(IntVec2 const& tileCoordsA, IntVec2 const& tileCoordsB) const;
 
-	void PopuplateDistanceField(std::vector<float>& out_distanceField, IntVec2 const& goalCoords, float specialValue = 9999.f) const;
-	void DebugRenderDistanceField(TileHeatMap const* heatMap) const;
-	void GenerateHeatMapPath(std::vector<Vec2>& out_positions, IntVec2 const& sourceCoords, IntVec2 const& destinationCoords, TileHeatMap const* heatMap) const;
-	void GenerateHeatMapPath(std::vector<IntVec2>& out_tileCoordsPath, IntVec2 const& sourceCoords, IntVec2 const& destinationCoords, TileHeatMap const* heatMap) const;
+	// Kept current by units as they are placed, move, cancel a move and die, so finding the unit on a tile never scans units
+	Unit* GetUnitOnTile(IntVec2 const& tileCoords) const;
+	void PlaceUnitOnTile(Unit* unit, IntVec2 const& tileCoords);
+	void RemoveUnitFromTile(Unit* unit, IntVec2 const& tileCoords);
+
+	// Calls callback(tileCoords, tileIndex) for every in-bounds tile whose distance from centerCoords is in [minRange, maxRange], nearest rings first
+	template <typename TileCallback>
+	void ForEachTileInRing(IntVec2 const& centerCoords, int minRange, int maxRange, TileCallback const& callback) const;
+
+	void PopuplateDistanceField(DistanceField& out_distanceField, IntVec2 const& goalCoords) const;
+	void PopulateMultiSourceDistanceField(DistanceField& out_distanceField, std::vector<int> const& sourceTileIndexes) const;
+	void DebugRenderDistanceField(DistanceField const* distanceField) const;
+	void DebugRenderInfluenceMap(InfluenceMap const* influenceMap) const;
+	void RefreshInfluenceMaps();
+
+	ReachableSet const& ComputeReachableSet(Unit const* unit);
+	void PlanGroupMove(std::vector<std::vector<IntVec2>>& out_tileCoordsPaths, std::vector<Unit*> const& units, IntVec2 const& targetCoords);
+	bool ComputeReachableBitboard(HexBitboard& out_reachableTiles, IntVec2 const& sourceCoords, int movementRange) const;
+	bool HasLineOfSight(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
+	void ComputeVisibleTiles(std::vector<int>& out_visibleTileIndexes, IntVec2 const& viewerCoords, int sightRange) const;
+	void RefreshUnitVisibility(Unit const* unit);
+	bool CanUnitAttackTile(Unit const* attackingUnit, IntVec2 const& targetCoords) const;
+	bool FindPath(std::vector<IntVec2>& out_tileCoordsPath, IntVec2 const& startCoords, IntVec2 const& goalCoords, int maxCost) const;
+	bool IsAnyOtherUnitWithinDistance(Unit const* unit, int distance) const;
+	std::shared_ptr<MapQuerySnapshot const> GetQuerySnapshot();
+	void UpdateMovePreviewQueries(Unit const* selectedUnit);
+	void NotifyBoardChanged();
+
+	void RebuildTilesVBO();
+	void RefreshMaxMovementCost();
 
 public:
 	static inline const Vec2 HEX_GRID_IBASIS = Vec2(0.866f, 0.5f);
 	static inline const Vec2 HEX_GRID_JBASIS = Vec2(0.f, 1.f);
 	static inline const Mat44 GRID_TO_WORLD_TRANSFORM = Mat44(HEX_GRID_IBASIS, HEX_GRID_JBASIS, Vec2::ZERO);
-	static constexpr float SPECIAL_VALUE_FOR_HEATMAP = 9999.f;
 
 	Game* m_game = nullptr;
 	MapDefinition m_definition;
 
 	Material m_moonMaterial;
 
-	std::vector<Tile> m_tiles;
+	HexGrid<Tile> m_tiles;
+	HexGrid<unsigned char> m_isTileBlocked;
+	HexGrid<unsigned char> m_tileMovementCosts;
+	HexGrid<Unit*> m_tileUnits;
+	// Kept in step with m_tileUnits by PlaceUnitOnTile and RemoveUnitFromTile, in the byte layout the searches take
+	HexGrid<unsigned char> m_isTileOccupied;
+	int m_maxMovementCost = 1;
+	HexNeighborTable m_neighborTable;
+	mutable DistanceFieldFrontier m_distanceFieldFrontier;
+	mutable DistanceFieldBucketQueue m_distanceFieldBucketQueue;
+	mutable HexRangeTable m_rangeTable;
 	IntVec2 m_hoveredTile = IntVec2(-1, -1);
+	CursorPicker m_cursorPicker;
 
 	VertexBuffer* m_mapVBO = nullptr;
 	VertexBuffer* m_tilesVBO = nullptr;
+	MapOverlay m_overlay;
+
+	// Filled on demand for the F1 view of the selected unit's distance to every tile
+	mutable DistanceField m_debugDistanceField;
+
+	ReachableSet m_reachableSet;
+	DistanceField m_groupFlowField;
+	std::vector<unsigned char> m_groupMovementCosts;
+	std::vector<unsigned char> m_groupIsTileOccupied;
+	std::vector<int> m_groupGoalTileIndexes;
+	mutable PathSearchState m_pathSearchState;
+
+	// Only built for maps with at most allPairsDistanceMaxTiles tiles, since it holds one entry per pair of tiles
+	// The default of 256 covers the 12x12 skirmish maps in about 20 KB; past that the reachable-set bitboards are cheap enough
+	AllPairsDistanceTable m_allPairsDistanceTable;
+
+	// The move preview in Render only shows results of queries run on m_mapQueryQueue, so the main thread never searches for it
+	MapQueryQueue* m_mapQueryQueue = nullptr;
+	std::shared_ptr<MapQuerySnapshot const> m_querySnapshot;
+	ReachableSet m_previewReachableSet;
+	int m_previewReachableSetTicket = -1;
+	std::vector<IntVec2> m_previewPath;
+	IntVec2 m_previewPathGoalCoords = IntVec2(-1, -1);
+	unsigned int m_previewPathBoardVersion = 0;
+	int m_previewPathTicket = -1;
+
+	// Only maps up to 64 tiles wide keep bitboards; m_movementCostBitboards[c] holds the tiles costing c, with 0 for blocked tiles
+	bool m_hasBitboards = false;
+	std::vector<HexBitboard> m_movementCostBitboards;
+	HexBitboard m_occupiedBitboard;
+	mutable std::vector<HexBitboard> m_reachableLayers;
+	mutable HexBitboard m_dilatedBitboard;
+	unsigned int m_boardVersion = 0;
 
 	std::vector<Unit*> m_units;
 
 	bool m_debugDraw = false;
 };
 
+//----------------------------------------------------------------------------------------------------------
+template <typename TileCallback>
+void Map::ForEachTileInRing(IntVec2 const& centerCoords, int minRange, int maxRange, TileCallback const& callback) const
+{
+	if (minRange < 0)
+	{
+		minRange = 0;
+	}
+	if (maxRange < minRange)
+	{
+		return;
+	}
+
+	// The table is sized for the longest range in UnitDefinitions.xml, so this only grows for unusual queries
+	if (maxRange > m_rangeTable.GetMaxRadius())
+	{
+		m_rangeTable.Build(maxRange);
+	}
+
+	int firstOffsetIndex = m_rangeTable.m_firstOffsetIndexes[minRange];
+	int endOffsetIndex = m_rangeTable.m_firstOffsetIndexes[maxRange + 1];
+	for (int offsetIndex = firstOffsetIndex; offsetIndex < endOffsetIndex; offsetIndex++)
+	{
+		IntVec2 tileCoords = centerCoords + m_rangeTable.m_offsets[offsetIndex];
+		if (!m_tiles.IsInBounds(tileCoords))
+		{
+			continue;
+		}
+
+		callback(tileCoords, m_tiles.GetTileIndex(tileCoords));
+	}
+}
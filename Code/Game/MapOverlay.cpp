@@ -0,0 +1,135 @@
+#include "Game/MapOverlay.hpp"
+
+#include "Game/GameCommon.hpp"
+#include "Game/Tile.hpp"
+
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+
+HexOverlayInstance::HexOverlayInstance(Vec3 const& position, HexOverlayStyle style, Rgba8 const& color, float radiusScale)
+	: m_position(position)
+	, m_style(style)
+	, m_color(color)
+	, m_radiusScale(radiusScale)
+{
+}
+
+bool MapOverlayKey::operator==(MapOverlayKey const& compare) const
+{
+	return m_isShown == compare.m_isShown && m_unit == compare.m_unit && m_tileCoords == compare.m_tileCoords && m_boardVersion == compare.m_boardVersion
+		&& m_numTiles == compare.m_numTiles && m_color.r == compare.m_color.r && m_color.g == compare.m_color.g && m_color.b == compare.m_color.b && m_color.a == compare.m_color.a;
+}
+
+bool MapOverlayKey::operator!=(MapOverlayKey const& compare) const
+{
+	return !(*this == compare);
+}
+
+MapOverlay::~MapOverlay()
+{
+	for (int layerIndex = 0; layerIndex < (int)MapOverlayLayer::NUM; layerIndex++)
+	{
+		delete m_layers[layerIndex].m_vbo;
+		m_layers[layerIndex].m_vbo = nullptr;
+	}
+}
+
+MapOverlay::MapOverlay()
+{
+	float const hexRadius = Tile::HEX_RADIUS;
+
+	AddVertsForRing3D(m_styleMeshes[(int)HexOverlayStyle::HOVER], Vec3::ZERO, hexRadius * 0.8f, 0.04f, EulerAngles::ZERO, Rgba8::WHITE, 6);
+
+	AddVertsForRing3D(m_styleMeshes[(int)HexOverlayStyle::MOVE_RANGE], Vec3::ZERO, hexRadius, 0.06f, EulerAngles::ZERO, Rgba8::WHITE, 6);
+	AddVertsForDisc3D(m_styleMeshes[(int)HexOverlayStyle::MOVE_RANGE], Vec3::ZERO, hexRadius, Rgba8(255, 255, 255, 127), 6);
+
+	AddVertsForRing3D(m_styleMeshes[(int)HexOverlayStyle::PATH], Vec3::ZERO, hexRadius, 0.08f, EulerAngles::ZERO, Rgba8::WHITE, 6);
+	AddVertsForDisc3D(m_styleMeshes[(int)HexOverlayStyle::PATH], Vec3::ZERO, hexRadius, Rgba8(255, 255, 255, 127), 6);
+
+	AddVertsForDisc3D(m_styleMeshes[(int)HexOverlayStyle::ATTACK_TARGET], Vec3::ZERO, hexRadius * 0.8f, Rgba8::MAROON, 6);
+}
+
+bool MapOverlay::IsLayerDirty(MapOverlayLayer layer, MapOverlayKey const& key) const
+{
+	MapOverlayLayerData const& layerData = m_layers[(int)layer];
+	return !layerData.m_isBuilt || layerData.m_key != key;
+}
+
+std::vector<HexOverlayInstance>& MapOverlay::BeginLayer(MapOverlayLayer layer, MapOverlayKey const& key)
+{
+	MapOverlayLayerData& layerData = m_layers[(int)layer];
+	layerData.m_key = key;
+	layerData.m_instances.clear();
+	return layerData.m_instances;
+}
+
+void MapOverlay::EndLayer(MapOverlayLayer layer)
+{
+	MapOverlayLayerData& layerData = m_layers[(int)layer];
+	m_layerVertexes.clear();
+	for (int instanceIndex = 0; instanceIndex < (int)layerData.m_instances.size(); instanceIndex++)
+	{
+		AddVertsForInstance(m_layerVertexes, layerData.m_instances[instanceIndex]);
+	}
+
+	layerData.m_isBuilt = true;
+	layerData.m_numVertexes = (int)m_layerVertexes.size();
+	m_numLayerRebuilds++;
+
+	if (layerData.m_numVertexes == 0)
+	{
+		return;
+	}
+
+	// The buffer only grows, so after the first few selections a rebuild is just a copy into memory the GPU already has
+	size_t numBytes = m_layerVertexes.size() * sizeof(Vertex_PCU);
+	if (!layerData.m_vbo || layerData.m_vbo->m_size < numBytes)
+	{
+		delete layerData.m_vbo;
+		layerData.m_vbo = g_renderer->CreateVertexBuffer(numBytes);
+	}
+	g_renderer->CopyCPUToGPU(m_layerVertexes.data(), numBytes, layerData.m_vbo);
+}
+
+void MapOverlay::Invalidate()
+{
+	for (int layerIndex = 0; layerIndex < (int)MapOverlayLayer::NUM; layerIndex++)
+	{
+		m_layers[layerIndex].m_isBuilt = false;
+	}
+}
+
+void MapOverlay::Render() const
+{
+	for (int layerIndex = 0; layerIndex < (int)MapOverlayLayer::NUM; layerIndex++)
+	{
+		MapOverlayLayerData const& layerData = m_layers[layerIndex];
+		if (!layerData.m_isBuilt || layerData.m_numVertexes == 0)
+		{
+			continue;
+		}
+
+		g_renderer->SetModelConstants(Mat44::IDENTITY, layerData.m_key.m_color);
+		g_renderer->DrawVertexBuffer(layerData.m_vbo, layerData.m_numVertexes);
+	}
+}
+
+void MapOverlay::AddVertsForInstance(std::vector<Vertex_PCU>& verts, HexOverlayInstance const& instance) const
+{
+	std::vector<Vertex_PCU> const& styleMesh = m_styleMeshes[(int)instance.m_style];
+	Rgba8 const& instanceColor = instance.m_color;
+	for (int vertexIndex = 0; vertexIndex < (int)styleMesh.size(); vertexIndex++)
+	{
+		Vertex_PCU vertex = styleMesh[vertexIndex];
+		vertex.m_position = instance.m_position + vertex.m_position * instance.m_radiusScale;
+		vertex.m_color.r = (unsigned char)(((int)vertex.m_color.r * (int)instanceColor.r) / 255);
+		vertex.m_color.g = (unsigned char)(((int)vertex.m_color.g * (int)instanceColor.g) / 255);
+		vertex.m_color.b = (unsigned char)(((int)vertex.m_color.b * (int)instanceColor.b) / 255);
+		vertex.m_color.a = (unsigned char)(((int)vertex.m_color.a * (int)instanceColor.a) / 255);
+		verts.push_back(vertex);
+	}
+}
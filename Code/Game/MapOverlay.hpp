@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+
+class Unit;
+class VertexBuffer;
+
+
+enum class MapOverlayLayer
+{
+	MOVE_RANGE,
+	PATH_PREVIEW,
+	ATTACK_TARGET,
+	HOVER,
+	NUM,
+};
+
+// Each style is one hex mesh built around the origin when the overlay is created
+enum class HexOverlayStyle : unsigned char
+{
+	HOVER,
+	MOVE_RANGE,
+	PATH,
+	ATTACK_TARGET,
+	NUM,
+};
+
+// One highlighted hex; layers store a list of these, and their vertexes are expanded from the style meshes
+struct HexOverlayInstance
+{
+public:
+	HexOverlayInstance() = default;
+	HexOverlayInstance(Vec3 const& position, HexOverlayStyle style, Rgba8 const& color = Rgba8::WHITE, float radiusScale = 1.f);
+
+public:
+	Vec3 m_position = Vec3::ZERO;
+	HexOverlayStyle m_style = HexOverlayStyle::HOVER;
+	Rgba8 m_color = Rgba8::WHITE;
+	float m_radiusScale = 1.f;
+};
+
+// Everything a layer's geometry depends on; a layer is only rebuilt when its key differs from the one it was last built for
+struct MapOverlayKey
+{
+public:
+	bool operator==(MapOverlayKey const& compare) const;
+	bool operator!=(MapOverlayKey const& compare) const;
+
+public:
+	bool m_isShown = false;
+	Unit const* m_unit = nullptr;
+	IntVec2 m_tileCoords = IntVec2(-1, -1);
+	unsigned int m_boardVersion = 0;
+	int m_numTiles = 0;
+	Rgba8 m_color = Rgba8::WHITE;
+};
+
+struct MapOverlayLayerData
+{
+public:
+	MapOverlayKey m_key;
+	std::vector<HexOverlayInstance> m_instances;
+	VertexBuffer* m_vbo = nullptr;
+	int m_numVertexes = 0;
+	bool m_isBuilt = false;
+};
+
+//----------------------------------------------------------------------------------------------------------
+// Tile highlights drawn over the map, one vertex buffer per layer, kept on the GPU between frames
+// Layers are drawn in the order of MapOverlayLayer, each tinted by its key's color
+// The renderer has no instanced draws, so a rebuilt layer copies each instance's style mesh into its buffer, offset and tinted;
+// no trig runs after construction, and a layer that did not change is not touched at all
+class MapOverlay
+{
+public:
+	~MapOverlay();
+	MapOverlay();
+
+	// Returns true if the layer needs new geometry, in which case the instance list handed out by BeginLayer must be filled and ended
+	bool IsLayerDirty(MapOverlayLayer layer, MapOverlayKey const& key) const;
+	std::vector<HexOverlayInstance>& BeginLayer(MapOverlayLayer layer, MapOverlayKey const& key);
+	void EndLayer(MapOverlayLayer layer);
+	void Invalidate();
+
+	void Render() const;
+
+private:
+	void AddVertsForInstance(std::vector<Vertex_PCU>& verts, HexOverlayInstance const& instance) const;
+
+public:
+	MapOverlayLayerData m_layers[(int)MapOverlayLayer::NUM];
+	std::vector<Vertex_PCU> m_styleMeshes[(int)HexOverlayStyle::NUM];
+	int m_numLayerRebuilds = 0;
+
+private:
+	std::vector<Vertex_PCU> m_layerVertexes;
+};
@@ -0,0 +1,273 @@
+#include "Game/MapQueryQueue.hpp"
+
+#include <algorithm>
+
+
+MapQueryQueue::~MapQueryQueue()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_isShuttingDown = true;
+	}
+	m_jobQueuedCondition.notify_all();
+
+	for (int workerIndex = 0; workerIndex < (int)m_workerThreads.size(); workerIndex++)
+	{
+		m_workerThreads[workerIndex].join();
+	}
+
+	for (int jobIndex = 0; jobIndex < (int)m_queuedJobs.size(); jobIndex++)
+	{
+		delete m_queuedJobs[jobIndex];
+	}
+	for (int jobIndex = 0; jobIndex < (int)m_completedJobs.size(); jobIndex++)
+	{
+		delete m_completedJobs[jobIndex];
+	}
+}
+
+MapQueryQueue::MapQueryQueue(int numWorkers)
+{
+	// Queries are only useful if something other than the main thread runs them, so there is always at least one worker
+	if (numWorkers < 1)
+	{
+		numWorkers = 1;
+	}
+
+	for (int workerIndex = 0; workerIndex < numWorkers; workerIndex++)
+	{
+		m_workerThreads.emplace_back(&MapQueryQueue::WorkerThreadMain, this);
+	}
+}
+
+int MapQueryQueue::SubmitPathQuery(std::shared_ptr<MapQuerySnapshot const> const& snapshot, IntVec2 const& startCoords, IntVec2 const& goalCoords, int maxCost, MapQueryCallback const& callback)
+{
+	MapQueryJob* job = new MapQueryJob();
+	job->m_snapshot = snapshot;
+	job->m_callback = callback;
+	job->m_result.m_type = MapQueryType::PATH;
+	job->m_result.m_boardVersion = snapshot->m_boardVersion;
+	job->m_result.m_startCoords = startCoords;
+	job->m_result.m_goalCoords = goalCoords;
+	job->m_result.m_maxCost = maxCost;
+	return SubmitJob(job);
+}
+
+int MapQueryQueue::SubmitReachableSetQuery(std::shared_ptr<MapQuerySnapshot const> const& snapshot, Unit const* unit, IntVec2 const& sourceCoords, int movementRange, MapQueryCallback const& callback)
+{
+	MapQueryJob* job = new MapQueryJob();
+	job->m_snapshot = snapshot;
+	job->m_callback = callback;
+	job->m_result.m_type = MapQueryType::REACHABLE_SET;
+	job->m_result.m_boardVersion = snapshot->m_boardVersion;
+	job->m_result.m_startCoords = sourceCoords;
+	job->m_result.m_goalCoords = sourceCoords;
+	job->m_result.m_maxCost = movementRange;
+	job->m_result.m_reachableSet.m_unit = unit;
+	return SubmitJob(job);
+}
+
+void MapQueryQueue::CancelQuery(int ticket)
+{
+	if (ticket < 0)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (int jobIndex = 0; jobIndex < (int)m_queuedJobs.size(); jobIndex++)
+	{
+		if (m_queuedJobs[jobIndex]->m_result.m_ticket == ticket)
+		{
+			delete m_queuedJobs[jobIndex];
+			m_queuedJobs.erase(m_queuedJobs.begin() + jobIndex);
+			return;
+		}
+	}
+	for (int jobIndex = 0; jobIndex < (int)m_completedJobs.size(); jobIndex++)
+	{
+		if (m_completedJobs[jobIndex]->m_result.m_ticket == ticket)
+		{
+			delete m_completedJobs[jobIndex];
+			m_completedJobs.erase(m_completedJobs.begin() + jobIndex);
+			return;
+		}
+	}
+
+	// A worker is still on it, so it gets dropped when the worker hands it back
+	if (std::find(m_runningTickets.begin(), m_runningTickets.end(), ticket) != m_runningTickets.end())
+	{
+		m_cancelledTickets.push_back(ticket);
+	}
+}
+
+bool MapQueryQueue::IsQueryPending(int ticket) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (int jobIndex = 0; jobIndex < (int)m_queuedJobs.size(); jobIndex++)
+	{
+		if (m_queuedJobs[jobIndex]->m_result.m_ticket == ticket)
+		{
+			return true;
+		}
+	}
+
+	return std::find(m_runningTickets.begin(), m_runningTickets.end(), ticket) != m_runningTickets.end();
+}
+
+bool MapQueryQueue::TryTakeResult(int ticket, MapQueryResult& out_result)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (int jobIndex = 0; jobIndex < (int)m_completedJobs.size(); jobIndex++)
+	{
+		MapQueryJob* job = m_completedJobs[jobIndex];
+		if (job->m_result.m_ticket == ticket)
+		{
+			out_result = std::move(job->m_result);
+			delete job;
+			m_completedJobs.erase(m_completedJobs.begin() + jobIndex);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void MapQueryQueue::DispatchCompletedQueries(unsigned int currentBoardVersion)
+{
+	std::vector<MapQueryJob*> jobsToDispatch;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (int jobIndex = 0; jobIndex < (int)m_completedJobs.size(); jobIndex++)
+		{
+			MapQueryJob* job = m_completedJobs[jobIndex];
+			bool isStale = job->m_result.m_boardVersion != currentBoardVersion;
+			if (!isStale && !job->m_callback)
+			{
+				// Waiting to be polled
+				continue;
+			}
+
+			if (isStale)
+			{
+				delete job;
+			}
+			else
+			{
+				jobsToDispatch.push_back(job);
+			}
+			m_completedJobs.erase(m_completedJobs.begin() + jobIndex);
+			jobIndex--;
+		}
+	}
+
+	// Callbacks run without the lock held, so they are free to submit or cancel queries
+	for (int jobIndex = 0; jobIndex < (int)jobsToDispatch.size(); jobIndex++)
+	{
+		jobsToDispatch[jobIndex]->m_callback(jobsToDispatch[jobIndex]->m_result);
+		delete jobsToDispatch[jobIndex];
+	}
+}
+
+int MapQueryQueue::SubmitJob(MapQueryJob* job)
+{
+	int ticket = -1;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		ticket = m_nextTicket;
+		m_nextTicket++;
+		job->m_result.m_ticket = ticket;
+		m_queuedJobs.push_back(job);
+	}
+	m_jobQueuedCondition.notify_one();
+
+	return ticket;
+}
+
+void MapQueryQueue::WorkerThreadMain()
+{
+	// Scratch lives on the worker's own stack, so workers never share anything but the read-only snapshots
+	PathSearchState pathSearchState;
+	DistanceFieldBucketQueue bucketQueue;
+	ReachableSet reachableSearchSet;
+
+	while (true)
+	{
+		MapQueryJob* job = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobQueuedCondition.wait(lock, [this]() { return m_isShuttingDown || !m_queuedJobs.empty(); });
+			if (m_isShuttingDown)
+			{
+				return;
+			}
+
+			job = m_queuedJobs.front();
+			m_queuedJobs.pop_front();
+			m_runningTickets.push_back(job->m_result.m_ticket);
+		}
+
+		RunJob(*job, pathSearchState, bucketQueue, reachableSearchSet);
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			int ticket = job->m_result.m_ticket;
+			m_runningTickets.erase(std::find(m_runningTickets.begin(), m_runningTickets.end(), ticket));
+
+			auto cancelledTicketIter = std::find(m_cancelledTickets.begin(), m_cancelledTickets.end(), ticket);
+			if (cancelledTicketIter != m_cancelledTickets.end())
+			{
+				m_cancelledTickets.erase(cancelledTicketIter);
+				delete job;
+			}
+			else
+			{
+				m_completedJobs.push_back(job);
+			}
+		}
+	}
+}
+
+void MapQueryQueue::RunJob(MapQueryJob& job, PathSearchState& pathSearchState, DistanceFieldBucketQueue& bucketQueue, ReachableSet& reachableSearchSet)
+{
+	MapQuerySnapshot const& snapshot = *job.m_snapshot;
+	MapQueryResult& result = job.m_result;
+	HexNeighborTable const& neighborTable = *snapshot.m_neighborTable;
+	std::vector<unsigned char> const& tileMovementCosts = *snapshot.m_tileMovementCosts;
+	int numTiles = neighborTable.GetNumTiles();
+	int sourceTileIndex = result.m_startCoords.y * neighborTable.m_dimensions.x + result.m_startCoords.x;
+
+	if (result.m_type == MapQueryType::PATH)
+	{
+		// The snapshot marks the moving unit's own tile as occupied too, which is fine since the search never re-enters the start
+		pathSearchState.Reserve(numTiles);
+		result.m_didSucceed = FindHexPath(result.m_tileCoordsPath, neighborTable, tileMovementCosts, snapshot.m_isTileOccupied, pathSearchState, result.m_startCoords, result.m_goalCoords, result.m_maxCost);
+		return;
+	}
+
+	// The worker searches in its own field, which is only reset where the last search touched it, and hands back just the reachable tiles
+	if (reachableSearchSet.m_distanceField.m_dimensions != neighborTable.m_dimensions)
+	{
+		reachableSearchSet.m_distanceField = DistanceField(neighborTable.m_dimensions);
+		reachableSearchSet.m_visitedTileIndexes.clear();
+	}
+	reachableSearchSet.Reset();
+	reachableSearchSet.m_movementRange = result.m_maxCost;
+	reachableSearchSet.m_distanceField.m_values[sourceTileIndex] = 0;
+	reachableSearchSet.m_visitedTileIndexes.push_back(sourceTileIndex);
+
+	bucketQueue.Reserve(numTiles, snapshot.m_maxMovementCost);
+	PopulateReachableSet(reachableSearchSet, neighborTable, tileMovementCosts, snapshot.m_isTileOccupied, sourceTileIndex, bucketQueue);
+
+	ReachableSet& reachableSet = result.m_reachableSet;
+	reachableSet.m_sourceCoords = result.m_startCoords;
+	reachableSet.m_movementRange = result.m_maxCost;
+	reachableSet.m_boardVersion = result.m_boardVersion;
+	reachableSet.m_tileIndexes = reachableSearchSet.m_tileIndexes;
+	result.m_reachableTileCosts.reserve(reachableSet.m_tileIndexes.size());
+	for (int reachableIndex = 0; reachableIndex < (int)reachableSet.m_tileIndexes.size(); reachableIndex++)
+	{
+		result.m_reachableTileCosts.push_back(reachableSearchSet.m_distanceField.m_values[reachableSet.m_tileIndexes[reachableIndex]]);
+	}
+	result.m_didSucceed = true;
+}
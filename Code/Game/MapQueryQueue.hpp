@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Game/PathSearchState.hpp"
+#include "Game/ReachableSet.hpp"
+
+#include "Engine/Math/IntVec2.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class Unit;
+
+
+// Read-only copy of what path and reachability queries look at, taken once per board version and shared by every query against it
+// The neighbor table is not copied since it never changes while the map exists, and the map outlives its query queue
+// Terrain costs never change during a game, so consecutive snapshots share them and copy just the occupancy
+struct MapQuerySnapshot
+{
+public:
+	unsigned int m_boardVersion = 0;
+	HexNeighborTable const* m_neighborTable = nullptr;
+	std::shared_ptr<std::vector<unsigned char> const> m_tileMovementCosts;
+	std::vector<unsigned char> m_isTileOccupied;
+	int m_maxMovementCost = 1;
+};
+
+enum class MapQueryType
+{
+	PATH,
+	REACHABLE_SET,
+};
+
+struct MapQueryResult
+{
+public:
+	int m_ticket = -1;
+	MapQueryType m_type = MapQueryType::PATH;
+	unsigned int m_boardVersion = 0;
+	IntVec2 m_startCoords = IntVec2::ZERO;
+	IntVec2 m_goalCoords = IntVec2::ZERO;
+	int m_maxCost = 0;
+	bool m_didSucceed = false;
+
+	// Filled by PATH queries, from the start to the goal with both included
+	std::vector<IntVec2> m_tileCoordsPath;
+
+	// Filled by REACHABLE_SET queries; m_reachableSet.m_unit is only ever compared, never dereferenced off the main thread
+	// The distance field stays with the worker, so m_reachableTileCosts[i] holds the cost of m_reachableSet.m_tileIndexes[i]
+	ReachableSet m_reachableSet;
+	std::vector<unsigned short> m_reachableTileCosts;
+};
+
+// Callbacks run on the main thread and may move the vectors out of the result
+typedef std::function<void(MapQueryResult& result)> MapQueryCallback;
+
+struct MapQueryJob
+{
+public:
+	std::shared_ptr<MapQuerySnapshot const> m_snapshot;
+	MapQueryCallback m_callback;
+	MapQueryResult m_result;
+};
+
+//----------------------------------------------------------------------------------------------------------
+// Runs path and reachability queries on worker threads so the main thread never waits on a search
+// Submitting returns a ticket, and the result comes back on the main thread, either through the query's callback from
+// DispatchCompletedQueries or by polling TryTakeResult; results for an older board version or a cancelled ticket are dropped
+class MapQueryQueue
+{
+public:
+	~MapQueryQueue();
+	explicit MapQueryQueue(int numWorkers);
+
+	int SubmitPathQuery(std::shared_ptr<MapQuerySnapshot const> const& snapshot, IntVec2 const& startCoords, IntVec2 const& goalCoords, int maxCost, MapQueryCallback const& callback);
+	int SubmitReachableSetQuery(std::shared_ptr<MapQuerySnapshot const> const& snapshot, Unit const* unit, IntVec2 const& sourceCoords, int movementRange, MapQueryCallback const& callback);
+	void CancelQuery(int ticket);
+	bool IsQueryPending(int ticket) const;
+
+	// Polling is for queries submitted without a callback; returns false until the result is in, or if it was dropped
+	bool TryTakeResult(int ticket, MapQueryResult& out_result);
+
+	// Call once a frame from the main thread before reading any results
+	void DispatchCompletedQueries(unsigned int currentBoardVersion);
+
+private:
+	int SubmitJob(MapQueryJob* job);
+	void WorkerThreadMain();
+	void RunJob(MapQueryJob& job, PathSearchState& pathSearchState, DistanceFieldBucketQueue& bucketQueue, ReachableSet& reachableSearchSet);
+
+private:
+	std::vector<std::thread> m_workerThreads;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_jobQueuedCondition;
+	bool m_isShuttingDown = false;
+	int m_nextTicket = 0;
+	std::deque<MapQueryJob*> m_queuedJobs;
+	std::vector<int> m_runningTickets;
+	std::vector<int> m_cancelledTickets;
+	std::vector<MapQueryJob*> m_completedJobs;
+};
@@ -2,10 +2,21 @@
 
 #include "Game/GameCommon.hpp"
 
+#include "Engine/Core/Image.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
 
-std::map<std::string, Texture*> Particle::s_particleTextures;
+
+Texture* Particle::s_atlasTexture = nullptr;
+std::vector<AABB2> Particle::s_spriteUVs;
+std::map<std::string, int> Particle::s_spriteHandlesByName;
+int Particle::s_lightSmokeSprite = -1;
+int Particle::s_darkSmokeSprite = -1;
+int Particle::s_muzzleFlash1Sprite = -1;
+int Particle::s_muzzleFlash2Sprite = -1;
 
 
 Particle::Particle(
@@ -16,7 +27,7 @@ Particle::Particle(
 	float size,
 	Clock* parentClock,
 	float lifetime,
-	std::string const& textureName,
+	int spriteHandle,
 	Rgba8 const& color,
 	float startAlpha,
 	float endAlpha,
@@ -35,6 +46,7 @@ Particle::Particle(
 	, m_size(size)
 	, m_lifetimeTimer(parentClock, lifetime)
 	, m_color(color)
+	, m_spriteHandle(spriteHandle)
 	, m_rotation(rotation)
 	, m_rotationSpeed(rotationSpeed)
 	, m_startAlpha(startAlpha)
@@ -51,12 +63,6 @@ Particle::Particle(
 	, m_endSpeedTime(endSpeedTime)
 {
 	m_lifetimeTimer.Start();
-
-	auto particleTexturesIter = s_particleTextures.find(textureName);
-	if (particleTexturesIter != s_particleTextures.end())
-	{
-		m_texture = particleTexturesIter->second;
-	}
 }
 
 void Particle::Update(float deltaSeconds)
@@ -76,37 +82,99 @@ void Particle::Update(float deltaSeconds)
 	m_rotation += m_rotationSpeed * deltaSeconds;
 }
 
-void Particle::Render(Camera const& camera) const
+void Particle::AddVerts(std::vector<Vertex_PCU>& verts, Camera const& camera) const
 {
-	std::vector<Vertex_PCU> particleVerts;
-	AddVertsForQuad3D(particleVerts, Vec3(0.f, -m_size * m_scale * 0.5f, -m_size * m_scale * 0.5f), Vec3(0.f, m_size * m_scale * 0.5f, -m_size * m_scale * 0.5f), Vec3(0.f, m_size * m_scale * 0.5f, m_size * m_scale * 0.5f), Vec3(0.f, -m_size * m_scale * 0.5f, m_size * m_scale * 0.5f), Rgba8::WHITE);
+	if (m_spriteHandle < 0 || m_spriteHandle >= (int)s_spriteUVs.size())
+	{
+		return;
+	}
 
+	float halfSize = m_size * m_scale * 0.5f;
 	Mat44 billboardMatrix = GetBillboardMatrix(BillboardType::FULL_OPPOSING, camera.GetModelMatrix(), m_position);
 	billboardMatrix.AppendXRotation(m_rotation);
 
-	g_renderer->SetDepthMode(DepthMode::DISABLED);
-	//g_theRenderer->SetDepthMode(DepthMode::READ_ONLY_LESS_EQUAL);
-	g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_BACK);
-	g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
-	g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
-	g_renderer->SetBlendMode(BlendMode::ALPHA);
-	g_renderer->BindTexture(m_texture);
-	g_renderer->BindShader(nullptr);
-	g_renderer->SetModelConstants(billboardMatrix, Rgba8(m_color.r, m_color.g, m_color.b, m_opacity));
-	g_renderer->DrawVertexArray(particleVerts);
+	Vec3 bottomLeft = billboardMatrix.TransformPosition3D(Vec3(0.f, -halfSize, -halfSize));
+	Vec3 bottomRight = billboardMatrix.TransformPosition3D(Vec3(0.f, halfSize, -halfSize));
+	Vec3 topRight = billboardMatrix.TransformPosition3D(Vec3(0.f, halfSize, halfSize));
+	Vec3 topLeft = billboardMatrix.TransformPosition3D(Vec3(0.f, -halfSize, halfSize));
+	AddVertsForQuad3D(verts, bottomLeft, bottomRight, topRight, topLeft, Rgba8(m_color.r, m_color.g, m_color.b, m_opacity), s_spriteUVs[m_spriteHandle]);
+}
+
+Texture* Particle::GetTexture() const
+{
+	return s_atlasTexture;
 }
 
 void Particle::InitializeParticleTextures()
 {
-	Texture* texture = g_renderer->CreateOrGetTextureFromFile("Data/Images/Particles/Smoke01.png");
-	s_particleTextures["Light Smoke"] = texture;
+	std::vector<std::string> imageFilePaths;
+	for (std::filesystem::directory_entry const& directoryEntry : std::filesystem::directory_iterator("Data/Images/Particles"))
+	{
+		if (directoryEntry.is_regular_file() && directoryEntry.path().extension() == ".png")
+		{
+			imageFilePaths.push_back(directoryEntry.path().generic_string());
+		}
+	}
+	if (imageFilePaths.empty())
+	{
+		ERROR_AND_DIE("No particle images found in Data/Images/Particles!");
+	}
+	std::sort(imageFilePaths.begin(), imageFilePaths.end());
+
+	std::vector<Image> images;
+	images.reserve(imageFilePaths.size());
+	IntVec2 cellDimensions = IntVec2::ZERO;
+	for (int imageIndex = 0; imageIndex < (int)imageFilePaths.size(); imageIndex++)
+	{
+		images.emplace_back(imageFilePaths[imageIndex].c_str());
+		IntVec2 imageDimensions = images.back().GetDimensions();
+		cellDimensions.x = (std::max)(cellDimensions.x, imageDimensions.x);
+		cellDimensions.y = (std::max)(cellDimensions.y, imageDimensions.y);
+	}
 
-	texture = g_renderer->CreateOrGetTextureFromFile("Data/Images/Particles/Smoke02.png");
-	s_particleTextures["Dark Smoke"] = texture;
+	// Images are laid out in a roughly square grid of equal cells, filled row by row from the bottom left
+	int numImages = (int)images.size();
+	int numColumns = (int)ceilf(sqrtf((float)numImages));
+	int numRows = (numImages + numColumns - 1) / numColumns;
+	IntVec2 atlasDimensions(numColumns * cellDimensions.x, numRows * cellDimensions.y);
+	Image atlasImage(atlasDimensions, Rgba8(0, 0, 0, 0));
+
+	s_spriteUVs.clear();
+	s_spriteHandlesByName.clear();
+	for (int imageIndex = 0; imageIndex < numImages; imageIndex++)
+	{
+		Image const& image = images[imageIndex];
+		IntVec2 imageDimensions = image.GetDimensions();
+		IntVec2 cellMins((imageIndex % numColumns) * cellDimensions.x, (imageIndex / numColumns) * cellDimensions.y);
+		for (int texelY = 0; texelY < imageDimensions.y; texelY++)
+		{
+			for (int texelX = 0; texelX < imageDimensions.x; texelX++)
+			{
+				atlasImage.SetTexelColor(IntVec2(cellMins.x + texelX, cellMins.y + texelY), image.GetTexelColor(IntVec2(texelX, texelY)));
+			}
+		}
+
+		Vec2 uvMins((float)cellMins.x / (float)atlasDimensions.x, (float)cellMins.y / (float)atlasDimensions.y);
+		Vec2 uvMaxs((float)(cellMins.x + imageDimensions.x) / (float)atlasDimensions.x, (float)(cellMins.y + imageDimensions.y) / (float)atlasDimensions.y);
+		s_spriteHandlesByName[std::filesystem::path(imageFilePaths[imageIndex]).stem().string()] = (int)s_spriteUVs.size();
+		s_spriteUVs.push_back(AABB2(uvMins, uvMaxs));
+	}
 
-	texture = g_renderer->CreateOrGetTextureFromFile("Data/Images/Particles/Fire01.png");
-	s_particleTextures["Muzzle Flash 1"] = texture;
+	s_atlasTexture = g_renderer->CreateTextureFromImage(atlasImage);
+
+	s_lightSmokeSprite = GetSpriteHandle("Smoke01");
+	s_darkSmokeSprite = GetSpriteHandle("Smoke02");
+	s_muzzleFlash1Sprite = GetSpriteHandle("Fire01");
+	s_muzzleFlash2Sprite = GetSpriteHandle("Fire02");
+}
+
+int Particle::GetSpriteHandle(std::string const& spriteName)
+{
+	auto spriteHandlesIter = s_spriteHandlesByName.find(spriteName);
+	if (spriteHandlesIter == s_spriteHandlesByName.end())
+	{
+		return -1;
+	}
 
-	texture = g_renderer->CreateOrGetTextureFromFile("Data/Images/Particles/Fire02.png");
-	s_particleTextures["Muzzle Flash 2"] = texture;
+	return spriteHandlesIter->second;
 }
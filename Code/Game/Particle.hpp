@@ -3,11 +3,13 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Stopwatch.hpp"
+#include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
-#include <string>
 #include <map>
+#include <string>
+#include <vector>
 
 class Texture;
 
@@ -23,7 +25,7 @@ public:
 				float size,
 				Clock* parentClock,
 				float lifetime,
-				std::string const& textureName,
+				int spriteHandle,
 				Rgba8 const& color,
 				float startAlpha,
 				float endAlpha,
@@ -40,9 +42,14 @@ public:
 	);
 
 	void Update(float deltaSeconds);
-	void Render(Camera const& camera) const;
+	// Appends the particle's camera-facing quad in world space, tinted and faded, ready to batch with others sharing its texture
+	void AddVerts(std::vector<Vertex_PCU>& verts, Camera const& camera) const;
 
+	Texture* GetTexture() const;
+
+	// Packs every image under Data/Images/Particles into one atlas texture; sprite handles index s_spriteUVs
 	static void InitializeParticleTextures();
+	static int GetSpriteHandle(std::string const& spriteName);
 
 public:
 	Vec3 m_position = Vec3::ZERO;
@@ -50,7 +57,7 @@ public:
 	float m_size = 0.f;
 	Rgba8 m_color = Rgba8::WHITE;
 	unsigned char m_opacity = 255;
-	Texture* m_texture = nullptr;
+	int m_spriteHandle = -1;
 	Stopwatch m_lifetimeTimer;
 	bool m_isDestroyed = false;
 	float m_rotation = 0.f;
@@ -70,5 +77,13 @@ public:
 	float m_scale = 1.f;
 	float m_speedMultiplier = 1.f;
 
-	static std::map<std::string, Texture*> s_particleTextures;
+	static Texture* s_atlasTexture;
+	static std::vector<AABB2> s_spriteUVs;
+	static std::map<std::string, int> s_spriteHandlesByName;
+
+	// Sprites gameplay code spawns, looked up once when the atlas is built
+	static int s_lightSmokeSprite;
+	static int s_darkSmokeSprite;
+	static int s_muzzleFlash1Sprite;
+	static int s_muzzleFlash2Sprite;
 };
@@ -0,0 +1,94 @@
+#include "Game/ParticleRenderer.hpp"
+
+#include "Game/GameCommon.hpp"
+#include "Game/Particle.hpp"
+
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+
+ParticleRenderer::~ParticleRenderer()
+{
+	for (int batchIndex = 0; batchIndex < (int)m_batches.size(); batchIndex++)
+	{
+		delete m_batches[batchIndex].m_vbo;
+		m_batches[batchIndex].m_vbo = nullptr;
+	}
+}
+
+void ParticleRenderer::Render(std::vector<Particle> const& particles, Camera const& camera)
+{
+	m_numDrawCalls = 0;
+	for (int batchIndex = 0; batchIndex < (int)m_batches.size(); batchIndex++)
+	{
+		m_batches[batchIndex].m_vertexes.clear();
+	}
+
+	for (int particleIndex = 0; particleIndex < (int)particles.size(); particleIndex++)
+	{
+		Particle const& particle = particles[particleIndex];
+		if (particle.m_isDestroyed)
+		{
+			continue;
+		}
+
+		particle.AddVerts(GetBatchForTexture(particle.GetTexture()).m_vertexes, camera);
+	}
+
+	g_renderer->SetDepthMode(DepthMode::DISABLED);
+	g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_BACK);
+	g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
+	g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
+	g_renderer->SetBlendMode(BlendMode::ALPHA);
+	g_renderer->BindShader(nullptr);
+	g_renderer->SetModelConstants();
+
+	for (int batchIndex = 0; batchIndex < (int)m_batches.size(); batchIndex++)
+	{
+		ParticleBatch& batch = m_batches[batchIndex];
+		if (batch.m_vertexes.empty())
+		{
+			continue;
+		}
+
+		// Buffers double when a burst outgrows them, so they settle at the size of the largest explosion seen
+		size_t numBytes = batch.m_vertexes.size() * sizeof(Vertex_PCU);
+		if (!batch.m_vbo || batch.m_vbo->m_size < numBytes)
+		{
+			size_t capacityBytes = (size_t)(INITIAL_PARTICLES_PER_BATCH * VERTEXES_PER_PARTICLE) * sizeof(Vertex_PCU);
+			if (batch.m_vbo)
+			{
+				capacityBytes = batch.m_vbo->m_size * 2;
+			}
+			while (capacityBytes < numBytes)
+			{
+				capacityBytes *= 2;
+			}
+
+			delete batch.m_vbo;
+			batch.m_vbo = g_renderer->CreateVertexBuffer(capacityBytes);
+		}
+		g_renderer->CopyCPUToGPU(batch.m_vertexes.data(), numBytes, batch.m_vbo);
+
+		g_renderer->BindTexture(batch.m_texture);
+		g_renderer->DrawVertexBuffer(batch.m_vbo, (int)batch.m_vertexes.size());
+		m_numDrawCalls++;
+	}
+}
+
+ParticleBatch& ParticleRenderer::GetBatchForTexture(Texture* texture)
+{
+	for (int batchIndex = 0; batchIndex < (int)m_batches.size(); batchIndex++)
+	{
+		if (m_batches[batchIndex].m_texture == texture)
+		{
+			return m_batches[batchIndex];
+		}
+	}
+
+	ParticleBatch newBatch;
+	newBatch.m_texture = texture;
+	newBatch.m_vertexes.reserve(INITIAL_PARTICLES_PER_BATCH * VERTEXES_PER_PARTICLE);
+	m_batches.push_back(newBatch);
+	return m_batches.back();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Engine/Core/Vertex_PCU.hpp"
+
+#include <vector>
+
+
+class Camera;
+class Particle;
+class Texture;
+class VertexBuffer;
+
+
+struct ParticleBatch
+{
+public:
+	Texture* m_texture = nullptr;
+	std::vector<Vertex_PCU> m_vertexes;
+	VertexBuffer* m_vbo = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------------
+// Expands every live particle into one vertex stream per texture and draws each stream with a single call
+// Particles keep the order they are passed in within their texture's batch, so back-to-front sorting still holds per texture
+// Batches and their vertex buffers are kept between frames and only grow, so a frame allocates nothing once explosions have peaked
+class ParticleRenderer
+{
+public:
+	~ParticleRenderer();
+
+	void Render(std::vector<Particle> const& particles, Camera const& camera);
+
+private:
+	ParticleBatch& GetBatchForTexture(Texture* texture);
+
+public:
+	static constexpr int INITIAL_PARTICLES_PER_BATCH = 256;
+	static constexpr int VERTEXES_PER_PARTICLE = 6;
+
+	std::vector<ParticleBatch> m_batches;
+	int m_numDrawCalls = 0;
+};
@@ -0,0 +1,188 @@
+#include "Game/PathSearchState.hpp"
+
+#include "Game/DistanceField.hpp"
+#include "Game/HexGrid.hpp"
+
+#include <algorithm>
+
+
+static bool IsPathSearchNodeWorse(PathSearchNode const& nodeA, PathSearchNode const& nodeB)
+{
+	// Min-heap on estimated total cost; among equal estimates prefer the node furthest from the start, which is closest to the goal
+	if (nodeA.m_estimatedTotalCost != nodeB.m_estimatedTotalCost)
+	{
+		return nodeA.m_estimatedTotalCost > nodeB.m_estimatedTotalCost;
+	}
+	return nodeA.m_costFromStart < nodeB.m_costFromStart;
+}
+
+void PathSearchState::Reserve(int numTiles)
+{
+	if ((int)m_costsFromStart.size() < numTiles)
+	{
+		m_visitedQueryIndexes.resize(numTiles, 0);
+		m_closedQueryIndexes.resize(numTiles, 0);
+		m_costsFromStart.resize(numTiles, UNVISITED_COST);
+	}
+}
+
+void PathSearchState::BeginQuery()
+{
+	m_queryIndex++;
+	if (m_queryIndex == 0)
+	{
+		// The stamp wrapped around, so old stamps could collide with new queries
+		std::fill(m_visitedQueryIndexes.begin(), m_visitedQueryIndexes.end(), 0);
+		std::fill(m_closedQueryIndexes.begin(), m_closedQueryIndexes.end(), 0);
+		m_queryIndex = 1;
+	}
+
+	m_openHeap.clear();
+	m_numTilesExplored = 0;
+}
+
+bool PathSearchState::IsVisited(int tileIndex) const
+{
+	return m_visitedQueryIndexes[tileIndex] == m_queryIndex;
+}
+
+bool PathSearchState::IsClosed(int tileIndex) const
+{
+	return m_closedQueryIndexes[tileIndex] == m_queryIndex;
+}
+
+int PathSearchState::GetCostFromStart(int tileIndex) const
+{
+	if (!IsVisited(tileIndex))
+	{
+		return UNVISITED_COST;
+	}
+
+	return m_costsFromStart[tileIndex];
+}
+
+void PathSearchState::Visit(int tileIndex, int costFromStart, int estimatedTotalCost)
+{
+	m_visitedQueryIndexes[tileIndex] = m_queryIndex;
+	m_costsFromStart[tileIndex] = costFromStart;
+
+	PathSearchNode node;
+	node.m_estimatedTotalCost = estimatedTotalCost;
+	node.m_costFromStart = costFromStart;
+	node.m_tileIndex = tileIndex;
+	m_openHeap.push_back(node);
+	std::push_heap(m_openHeap.begin(), m_openHeap.end(), IsPathSearchNodeWorse);
+}
+
+void PathSearchState::Close(int tileIndex)
+{
+	m_closedQueryIndexes[tileIndex] = m_queryIndex;
+	m_numTilesExplored++;
+}
+
+bool PathSearchState::IsOpenEmpty() const
+{
+	return m_openHeap.empty();
+}
+
+PathSearchNode const& PathSearchState::PeekOpen() const
+{
+	return m_openHeap.front();
+}
+
+PathSearchNode PathSearchState::PopOpen()
+{
+	std::pop_heap(m_openHeap.begin(), m_openHeap.end(), IsPathSearchNodeWorse);
+	PathSearchNode node = m_openHeap.back();
+	m_openHeap.pop_back();
+	return node;
+}
+
+//----------------------------------------------------------------------------------------------------------
+bool FindHexPath(std::vector<IntVec2>& out_tileCoordsPath, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, std::vector<unsigned char> const& isTileOccupied, PathSearchState& searchState, IntVec2 const& startCoords, IntVec2 const& goalCoords, int maxCost)
+{
+	int mapWidth = neighborTable.m_dimensions.x;
+	int startTileIndex = startCoords.y * mapWidth + startCoords.x;
+	int goalTileIndex = goalCoords.y * mapWidth + goalCoords.x;
+	int goalCost = PathSearchState::UNVISITED_COST;
+
+	searchState.BeginQuery();
+	searchState.Visit(startTileIndex, 0, GetHexDistance(startCoords, goalCoords));
+
+	// Every step costs at least 1, so the hex distance never overestimates and A* closes tiles with their exact cost
+	// The search keeps going past the goal until the cheapest estimate exceeds the goal's cost, which closes every tile
+	// on every shortest path and lets the walk back below break ties exactly like the heat map descent does
+	while (!searchState.IsOpenEmpty())
+	{
+		PathSearchNode currentNode = searchState.PopOpen();
+		if (currentNode.m_estimatedTotalCost > goalCost)
+		{
+			break;
+		}
+		if (searchState.IsClosed(currentNode.m_tileIndex) || currentNode.m_costFromStart > searchState.GetCostFromStart(currentNode.m_tileIndex))
+		{
+			continue;
+		}
+
+		searchState.Close(currentNode.m_tileIndex);
+		if (currentNode.m_tileIndex == goalTileIndex)
+		{
+			goalCost = currentNode.m_costFromStart;
+			continue;
+		}
+
+		for (int neighborIndex = neighborTable.m_firstNeighborIndexes[currentNode.m_tileIndex]; neighborIndex < neighborTable.m_firstNeighborIndexes[currentNode.m_tileIndex + 1]; neighborIndex++)
+		{
+			int neighborTileIndex = neighborTable.m_neighborTileIndexes[neighborIndex];
+			int movementCost = tileMovementCosts[neighborTileIndex];
+			if (movementCost == 0 || isTileOccupied[neighborTileIndex] || searchState.IsClosed(neighborTileIndex))
+			{
+				continue;
+			}
+
+			int costFromStart = currentNode.m_costFromStart + movementCost;
+			if (costFromStart > maxCost || costFromStart >= searchState.GetCostFromStart(neighborTileIndex))
+			{
+				continue;
+			}
+
+			int estimatedTotalCost = costFromStart + GetHexDistance(IntVec2(neighborTileIndex % mapWidth, neighborTileIndex / mapWidth), goalCoords);
+			searchState.Visit(neighborTileIndex, costFromStart, estimatedTotalCost);
+		}
+	}
+
+	if (goalCost == PathSearchState::UNVISITED_COST)
+	{
+		return false;
+	}
+
+	size_t firstPathIndex = out_tileCoordsPath.size();
+	int currentTileIndex = goalTileIndex;
+	out_tileCoordsPath.push_back(goalCoords);
+	while (currentTileIndex != startTileIndex)
+	{
+		int minCost = searchState.GetCostFromStart(currentTileIndex);
+		int minCostTileIndex = currentTileIndex;
+
+		for (int neighborIndex = neighborTable.m_firstNeighborIndexes[currentTileIndex]; neighborIndex < neighborTable.m_firstNeighborIndexes[currentTileIndex + 1]; neighborIndex++)
+		{
+			int neighborTileIndex = neighborTable.m_neighborTileIndexes[neighborIndex];
+			if (searchState.GetCostFromStart(neighborTileIndex) < minCost)
+			{
+				minCost = searchState.GetCostFromStart(neighborTileIndex);
+				minCostTileIndex = neighborTileIndex;
+			}
+		}
+
+		if (minCostTileIndex == currentTileIndex)
+		{
+			break;
+		}
+
+		currentTileIndex = minCostTileIndex;
+		out_tileCoordsPath.push_back(IntVec2(currentTileIndex % mapWidth, currentTileIndex / mapWidth));
+	}
+
+	std::reverse(out_tileCoordsPath.begin() + firstPathIndex, out_tileCoordsPath.end());
+	return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+
+
+class HexNeighborTable;
+
+
+struct PathSearchNode
+{
+public:
+	int m_estimatedTotalCost = 0;
+	int m_costFromStart = 0;
+	int m_tileIndex = -1;
+};
+
+// Per-tile scratch for point to point searches, reused across queries
+// Tiles are stamped with the query that last touched them, so starting a new query never clears the arrays
+class PathSearchState
+{
+public:
+	void Reserve(int numTiles);
+	void BeginQuery();
+
+	bool IsVisited(int tileIndex) const;
+	bool IsClosed(int tileIndex) const;
+	int GetCostFromStart(int tileIndex) const;
+	void Visit(int tileIndex, int costFromStart, int estimatedTotalCost);
+	void Close(int tileIndex);
+
+	bool IsOpenEmpty() const;
+	PathSearchNode const& PeekOpen() const;
+	PathSearchNode PopOpen();
+
+public:
+	static constexpr int UNVISITED_COST = 0x7FFFFFFF;
+
+	unsigned int m_queryIndex = 0;
+	std::vector<unsigned int> m_visitedQueryIndexes;
+	std::vector<unsigned int> m_closedQueryIndexes;
+	std::vector<int> m_costsFromStart;
+	std::vector<PathSearchNode> m_openHeap;
+
+	int m_numTilesExplored = 0;
+};
+
+// A* from startCoords to goalCoords that never enters blocked or occupied tiles, appending the path with both ends included
+// Safe to run on any thread as long as every thread brings its own searchState
+bool FindHexPath(std::vector<IntVec2>& out_tileCoordsPath, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, std::vector<unsigned char> const& isTileOccupied, PathSearchState& searchState, IntVec2 const& startCoords, IntVec2 const& goalCoords, int maxCost);
@@ -3,6 +3,7 @@
 #include "Game/App.hpp"
 #include "Game/Game.hpp"
 #include "Game/Map.hpp"
+#include "Game/Particle.hpp"
 #include "Game/UnitDefinition.hpp"
 #include "Game/Unit.hpp"
 
@@ -16,7 +17,6 @@ Player::Player(Game* game, int playerIndex, NetState netState)
 	, m_playerIndex(playerIndex)
 	, m_netState(netState)
 {
-	m_diffuseShader = g_renderer->CreateOrGetShader("Data/Shaders/Diffuse", VertexType::VERTEX_PCUTBN);
 }
 
 void Player::InitializeUnits(Map* map)
@@ -47,9 +47,16 @@ void Player::InitializeUnits(Map* map)
 			{
 				Unit* newUnit = new Unit(unitDefIter->second, map, tileCoords, tilePosition.ToVec3(), unitOrientation, this);
 				m_units.push_back(newUnit);
+				map->PlaceUnitOnTile(newUnit, tileCoords);
 			}
 		}
 	}
+
+	m_visibilityMap.Initialize(numTiles);
+	for (int unitIndex = 0; unitIndex < (int)m_units.size(); unitIndex++)
+	{
+		map->RefreshUnitVisibility(m_units[unitIndex]);
+	}
 }
 
 void Player::Update()
@@ -68,44 +75,33 @@ void Player::Update()
 		return;
 	}
 
-	RaycastResult3D raycastResult = m_game->m_currentMap->RaycastCursorVsMap();
-	int tileIndexForClosestTile = -1;
-	float closestTileDistance = FLT_MAX;
-	for (int tileIndex = 0; tileIndex < (int)m_game->m_currentMap->m_tiles.size(); tileIndex++)
+	// The hovered hex comes straight from the cursor's ground position, and is only picked again once the cursor or camera moves
+	Map* map = m_game->m_currentMap;
+	if (map->m_cursorPicker.Update(*map))
 	{
-		Vec2 tilePosition = m_game->m_currentMap->GetTileWorldPositionFromIndex(tileIndex);
-
-		if (!IsPointInsideAABB2(tilePosition, AABB2(m_game->m_currentMap->m_definition.m_bounds.m_mins.GetXY(), m_game->m_currentMap->m_definition.m_bounds.m_maxs.GetXY())))
-		{
-			continue;
-		}
-
-		float tileDistanceFromCursor = GetDistanceSquared2D(raycastResult.m_impactPosition.GetXY(), tilePosition);
-		if (tileDistanceFromCursor < closestTileDistance)
-		{
-			closestTileDistance = tileDistanceFromCursor;
-			tileIndexForClosestTile = tileIndex;
-		}
-
-		if (IsPointInsideHex(raycastResult.m_impactPosition.GetXY(), tilePosition, Tile::HEX_RADIUS))
+		IntVec2 const& tileCoords = map->m_cursorPicker.GetHoveredTileCoords();
+		if (tileCoords != IntVec2(-1, -1) && tileCoords != map->m_hoveredTile)
 		{
-			IntVec2 tileCoords = m_game->m_currentMap->GetTileCoordsFromIndex(tileIndex);
+			m_game->SetFocusedHex(tileCoords);
 
-			if (!m_game->m_currentMap->m_tiles[tileIndex].m_isHovered)
+			if (m_game->m_gameType == GameType::NETWORK)
 			{
-				m_game->SetFocusedHex(tileCoords);
-
-				if (m_game->m_gameType == GameType::NETWORK)
-				{
-					g_netSystem->QueueMessageForSend(Stringf("SetFocusedHex hexCoords=\"%d,%d\"", tileCoords.x, tileCoords.y));
-				}
+				g_netSystem->QueueMessageForSend(Stringf("SetFocusedHex hexCoords=\"%d,%d\"", tileCoords.x, tileCoords.y));
 			}
 		}
 	}
 
 	if (!m_game->m_hasGameEnded && !m_game->m_isAnimationPlaying && g_input->WasKeyJustPressed(KEYCODE_LMB))
 	{
-		if (m_turnState == TurnState::NO_SELECTION)
+		if (m_turnState == TurnState::NO_SELECTION && g_input->IsKeyDown(KEYCODE_SHIFT))
+		{
+			m_game->ToggleFocusedUnitInGroup();
+			if (m_game->m_gameType == GameType::NETWORK)
+			{
+				g_netSystem->QueueMessageForSend(Stringf("ToggleGroupUnit"));
+			}
+		}
+		else if (m_turnState == TurnState::NO_SELECTION)
 		{
 			m_game->SelectFocusedUnit();
 			if (m_game->m_gameType == GameType::NETWORK)
@@ -166,6 +162,16 @@ void Player::Update()
 		}
 	}
 
+	if (g_input->WasKeyJustPressed('G') && m_turnState == TurnState::NO_SELECTION && !m_groupUnits.empty() && !m_game->m_hasGameEnded && !m_game->m_isAnimationPlaying)
+	{
+		IntVec2 const& targetTileCoords = m_game->m_currentMap->m_hoveredTile;
+		m_game->GroupMove(targetTileCoords);
+		if (m_game->m_gameType == GameType::NETWORK)
+		{
+			g_netSystem->QueueMessageForSend(Stringf("GroupMove hexCoords=\"%d,%d\"", targetTileCoords.x, targetTileCoords.y));
+		}
+	}
+
 	if (g_input->WasKeyJustPressed('Y') && m_turnState == TurnState::NO_SELECTION && !m_game->m_isAnimationPlaying)
 	{
 		m_game->EndTurn();
@@ -212,7 +218,7 @@ void Player::Update()
 			float startSpeedTime = 0.f;
 			float endSpeedTime = 1.f;
 
-			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Light Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_lightSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 		}
 		// Spawn 12 dark smoke particles
 		for (int particleIndex = 0; particleIndex < 12; particleIndex++)
@@ -243,7 +249,7 @@ void Player::Update()
 			float startSpeedTime = 0.f;
 			float endSpeedTime = 1.f;
 
-			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Dark Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_darkSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 		}
 		// Spawn 3 type 1 fire particles
 		for (int particleIndex = 0; particleIndex < 3; particleIndex++)
@@ -272,7 +278,7 @@ void Player::Update()
 			float startSpeedTime = 0.f;
 			float endSpeedTime = 1.f;
 
-			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 1", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash1Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 		}
 		// Spawn 3 type 2 fire particles
 		for (int particleIndex = 0; particleIndex < 3; particleIndex++)
@@ -301,22 +307,9 @@ void Player::Update()
 			float startSpeedTime = 0.f;
 			float endSpeedTime = 1.f;
 
-			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 2", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
-		}
-	}
-}
-
-void Player::Render() const
-{
-	g_renderer->BeginCamera(m_game->m_worldCamera);
-	{
-		g_renderer->BindShader(m_diffuseShader);
-		for (int unitIndex = 0; unitIndex < (int)m_units.size(); unitIndex++)
-		{
-			m_units[unitIndex]->Render();
+			g_app->m_game->SpawnParticle(m_selectedUnit->m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash2Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 		}
 	}
-	g_renderer->EndCamera(m_game->m_worldCamera);
 }
 
 void Player::DebugRender() const
@@ -325,8 +318,13 @@ void Player::DebugRender() const
 	{
 		if (m_selectedUnit)
 		{
-			TileHeatMap const* heatMap = m_selectedUnit->m_heatMap;
-			m_game->m_currentMap->DebugRenderDistanceField(heatMap);
+			Map* map = m_game->m_currentMap;
+			map->PopuplateDistanceField(map->m_debugDistanceField, m_selectedUnit->m_tileCoords);
+			map->DebugRenderDistanceField(&map->m_debugDistanceField);
+		}
+		else if (m_turnState == TurnState::NO_SELECTION && m_game->GetWaitingPlayer())
+		{
+			m_game->m_currentMap->DebugRenderInfluenceMap(&m_game->GetWaitingPlayer()->m_threatMap);
 		}
 
 		if (m_selectedUnit && m_selectedUnit->m_pathSpline)
@@ -358,15 +356,13 @@ Rgba8 const Player::GetTeamColor()
 
 Unit* Player::GetUnitFromTileCoords(IntVec2 const& tileCoords) const
 {
-	for (int unitIndex = 0; unitIndex < (int)m_units.size(); unitIndex++)
-	{
-		if (m_units[unitIndex]->m_tileCoords == tileCoords)
-		{
-			return m_units[unitIndex];
-		}
-	}
+	Unit* unit = m_game->m_currentMap->GetUnitOnTile(tileCoords);
+	return (unit && unit->m_owner == this) ? unit : nullptr;
+}
 
-	return nullptr;
+bool Player::IsTileVisible(IntVec2 const& tileCoords) const
+{
+	return m_visibilityMap.IsTileVisible(m_game->m_currentMap->GetTileIndexFromCoords(tileCoords));
 }
 
 void Player::DeleteGarbageUnits()
@@ -375,6 +371,13 @@ void Player::DeleteGarbageUnits()
 	{
 		if (m_units[unitIndex]->m_isGarbage)
 		{
+			m_units[unitIndex]->m_map->NotifyBoardChanged();
+			m_visibilityMap.RemoveUnit(m_units[unitIndex]);
+			auto groupUnitIter = std::find(m_groupUnits.begin(), m_groupUnits.end(), m_units[unitIndex]);
+			if (groupUnitIter != m_groupUnits.end())
+			{
+				m_groupUnits.erase(groupUnitIter);
+			}
 			delete m_units[unitIndex];
 			m_units.erase(m_units.begin() + unitIndex);
 			unitIndex--;
@@ -391,4 +394,5 @@ void Player::EndTurn()
 		m_units[unitIndex]->m_isSelected = false;
 		m_units[unitIndex]->m_ordersIssued = false;
 	}
+	m_groupUnits.clear();
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Game/InfluenceMap.hpp"
+#include "Game/VisibilityMap.hpp"
+
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Renderer/Shader.hpp"
@@ -37,11 +40,11 @@ public:
 	void InitializeUnits(Map* map);
 
 	void Update();
-	void Render() const;
 	void DebugRender() const;
 
 	Rgba8 const GetTeamColor();
 	Unit* GetUnitFromTileCoords(IntVec2 const& tileCoords) const;
+	bool IsTileVisible(IntVec2 const& tileCoords) const;
 
 	void DeleteGarbageUnits();
 	void EndTurn();
@@ -53,6 +56,8 @@ public:
 	TurnState m_turnState = TurnState::WAITING_FOR_TURN;
 	std::vector<Unit*> m_units;
 	Unit* m_selectedUnit = nullptr;
-	Shader* m_diffuseShader = nullptr;
+	std::vector<Unit*> m_groupUnits;
+	VisibilityMap m_visibilityMap;
+	InfluenceMap m_threatMap;
 	bool m_isAlive = true;
 };
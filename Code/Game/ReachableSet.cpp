@@ -0,0 +1,90 @@
+#include "Game/ReachableSet.hpp"
+
+
+bool ReachableSet::IsTileReachable(int tileIndex) const
+{
+	if (tileIndex < 0 || tileIndex >= (int)m_distanceField.m_values.size())
+	{
+		return false;
+	}
+
+	return m_distanceField.m_values[tileIndex] != DistanceField::UNREACHABLE && m_distanceField.m_values[tileIndex] != 0;
+}
+
+void ReachableSet::Reset()
+{
+	// Only the tiles the last search touched need clearing, so a recompute never pays for the whole map
+	for (int visitedIndex = 0; visitedIndex < (int)m_visitedTileIndexes.size(); visitedIndex++)
+	{
+		m_distanceField.m_values[m_visitedTileIndexes[visitedIndex]] = DistanceField::UNREACHABLE;
+	}
+	m_visitedTileIndexes.clear();
+	m_tileIndexes.clear();
+	m_unit = nullptr;
+}
+
+void ReachableSet::CopyReachableTiles(ReachableSet const& source, std::vector<unsigned short> const& tileCosts)
+{
+	Reset();
+	m_unit = source.m_unit;
+	m_sourceCoords = source.m_sourceCoords;
+	m_movementRange = source.m_movementRange;
+	m_boardVersion = source.m_boardVersion;
+	m_tileIndexes = source.m_tileIndexes;
+
+	int sourceTileIndex = m_sourceCoords.y * m_distanceField.m_dimensions.x + m_sourceCoords.x;
+	m_distanceField.m_values[sourceTileIndex] = 0;
+	m_visitedTileIndexes.push_back(sourceTileIndex);
+	for (int reachableIndex = 0; reachableIndex < (int)m_tileIndexes.size(); reachableIndex++)
+	{
+		m_distanceField.m_values[m_tileIndexes[reachableIndex]] = tileCosts[reachableIndex];
+		m_visitedTileIndexes.push_back(m_tileIndexes[reachableIndex]);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------
+void PopulateReachableSet(ReachableSet& out_reachableSet, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, std::vector<unsigned char> const& isTileOccupied, int sourceTileIndex, DistanceFieldBucketQueue& bucketQueue)
+{
+	std::vector<unsigned short>& distances = out_reachableSet.m_distanceField.m_values;
+
+	// Dial's algorithm cut off at the movement range; tiles are appended to the set as they are settled, so it stays sorted by cost
+	bucketQueue.Clear();
+	bucketQueue.Insert(sourceTileIndex, 0);
+	while (!bucketQueue.IsEmpty())
+	{
+		int currentTileIndex = bucketQueue.PopMin();
+		int currentDistance = distances[currentTileIndex];
+		if (currentTileIndex != sourceTileIndex)
+		{
+			out_reachableSet.m_tileIndexes.push_back(currentTileIndex);
+		}
+
+		for (int neighborIndex = neighborTable.m_firstNeighborIndexes[currentTileIndex]; neighborIndex < neighborTable.m_firstNeighborIndexes[currentTileIndex + 1]; neighborIndex++)
+		{
+			int neighborTileIndex = neighborTable.m_neighborTileIndexes[neighborIndex];
+			int movementCost = tileMovementCosts[neighborTileIndex];
+			if (movementCost == 0 || isTileOccupied[neighborTileIndex])
+			{
+				continue;
+			}
+
+			int nextDistance = currentDistance + movementCost;
+			int neighborDistance = distances[neighborTileIndex];
+			if (nextDistance > out_reachableSet.m_movementRange || nextDistance >= neighborDistance)
+			{
+				continue;
+			}
+
+			if (neighborDistance == DistanceField::UNREACHABLE)
+			{
+				out_reachableSet.m_visitedTileIndexes.push_back(neighborTileIndex);
+			}
+			else
+			{
+				bucketQueue.Remove(neighborTileIndex, neighborDistance);
+			}
+			distances[neighborTileIndex] = (unsigned short)nextDistance;
+			bucketQueue.Insert(neighborTileIndex, nextDistance);
+		}
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Game/DistanceField.hpp"
+
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+
+
+class Unit;
+
+
+// Tiles a unit can move to this turn, found by a shortest path search from its tile that stops once the total movement cost exceeds its movement range
+// Blocked tiles and tiles holding any unit can neither be entered nor passed through
+class ReachableSet
+{
+public:
+	bool IsTileReachable(int tileIndex) const;
+	void Reset();
+
+	// Takes over the tiles of a set searched elsewhere, given their costs in the order of source.m_tileIndexes
+	// Only the source and reachable tiles are written, so this set's field must already be sized for the map
+	void CopyReachableTiles(ReachableSet const& source, std::vector<unsigned short> const& tileCosts);
+
+public:
+	Unit const* m_unit = nullptr;
+	IntVec2 m_sourceCoords = IntVec2(-1, -1);
+	int m_movementRange = -1;
+	unsigned int m_boardVersion = 0;
+
+	// Destination tiles in order of increasing movement cost, not including the unit's own tile
+	std::vector<int> m_tileIndexes;
+
+	// Movement costs from the unit's tile, UNREACHABLE for every tile the search did not reach
+	DistanceField m_distanceField;
+	std::vector<int> m_visitedTileIndexes;
+};
+
+// Fills a reset set whose source tile is already at distance 0 and in m_visitedTileIndexes, searching no further than m_movementRange
+void PopulateReachableSet(ReachableSet& out_reachableSet, HexNeighborTable const& neighborTable, std::vector<unsigned char> const& tileMovementCosts, std::vector<unsigned char> const& isTileOccupied, int sourceTileIndex, DistanceFieldBucketQueue& bucketQueue);
@@ -4,13 +4,19 @@
 
 
 Tile::Tile(TileDefinition const& definition)
-	: m_definition(definition)
+	: m_definitionIndex(definition.m_index)
 {
 }
 
+TileDefinition const& Tile::GetDefinition() const
+{
+	return TileDefinition::GetTileDefinitionFromIndex(m_definitionIndex);
+}
+
 void Tile::AddVerts(std::vector<Vertex_PCU>& verts, Vec3 const& position) const
 {
-	if (m_definition.m_isBlocked)
+	TileDefinition const& definition = GetDefinition();
+	if (definition.m_isBlocked)
 	{
 		//AddVertsForRing3D(verts, position, HEX_RADIUS, 0.02f, EulerAngles::ZERO, Rgba8::WHITE, 6);
 		AddVertsForDisc3D(verts, position, HEX_RADIUS, Rgba8::BLACK, 6);
@@ -18,40 +24,16 @@ void Tile::AddVerts(std::vector<Vertex_PCU>& verts, Vec3 const& position) const
 	else
 	{
 		AddVertsForRing3D(verts, position, HEX_RADIUS, 0.04f, EulerAngles::ZERO, Rgba8::WHITE, 6);
-	}
-}
-
-void Tile::AddVertsForHover(std::vector<Vertex_PCU>& verts, Vec3 const& position) const
-{
-	if (m_isHovered && !m_definition.m_isBlocked)
-	{
-		AddVertsForRing3D(verts, position, HEX_RADIUS * 0.8f, 0.04f, EulerAngles::ZERO, Rgba8::WHITE, 6);
-	}
-}
-
-void Tile::AddVertsForHighlight(std::vector<Vertex_PCU>& verts, Vec3 const& position) const
-{
-	if (!m_definition.m_isBlocked)
-	{
-		AddVertsForRing3D(verts, position, HEX_RADIUS, 0.06f, EulerAngles::ZERO, Rgba8::WHITE, 6);
-		AddVertsForDisc3D(verts, position, HEX_RADIUS, Rgba8(255, 255, 255, 127), 6);
-	}
-}
-
-void Tile::AddVertsForPathHighlight(std::vector<Vertex_PCU>& verts, Vec3 const& position) const
-{
-	if (!m_definition.m_isBlocked)
-	{
-		AddVertsForRing3D(verts, position, HEX_RADIUS, 0.08f, EulerAngles::ZERO, Rgba8::WHITE, 6);
-		AddVertsForDisc3D(verts, position, HEX_RADIUS, Rgba8(255, 255, 255, 127), 6);
-	}
-}
-
-void Tile::AddVertsForAttackHighlight(std::vector<Vertex_PCU>& verts, Vec3 const& position) const
-{
-	if (m_isHovered)
-	{
-		AddVertsForDisc3D(verts, position, HEX_RADIUS * 0.8f, Rgba8::MAROON, 6);
+		if (definition.m_movementCost > 1)
+		{
+			// Darken tiles that cost more to enter so rough terrain reads at a glance
+			int alpha = 40 * (definition.m_movementCost - 1);
+			if (alpha > 160)
+			{
+				alpha = 160;
+			}
+			AddVertsForDisc3D(verts, position, HEX_RADIUS, Rgba8(0, 0, 0, (unsigned char)alpha), 6);
+		}
 	}
 }
 
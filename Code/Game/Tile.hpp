@@ -17,16 +17,15 @@ public:
 	Tile(Tile const& copyFrom) = default;
 	Tile(TileDefinition const& definition);
 
+	TileDefinition const& GetDefinition() const;
+
 	void AddVerts(std::vector<Vertex_PCU>& verts, Vec3 const& position) const;
-	void AddVertsForHover(std::vector<Vertex_PCU>& verts, Vec3 const& position) const;
-	void AddVertsForHighlight(std::vector<Vertex_PCU>& verts, Vec3 const& position) const;
-	void AddVertsForPathHighlight(std::vector<Vertex_PCU>& verts, Vec3 const& position) const;
-	void AddVertsForAttackHighlight(std::vector<Vertex_PCU>& verts, Vec3 const& position) const;
 	void AddHeatVerts(std::vector<Vertex_PCU>& verts, Vec3 const& position, Rgba8 const& color) const;
 
 public:
 	static inline const float HEX_RADIUS = 1.f / sqrtf(3);
 
-	TileDefinition m_definition;
-	bool m_isHovered = false;
+	// Tiles are stored once per map cell, so they only keep an index into TileDefinition::s_definitions
+	// Hover and highlight state lives on the Map, which only ever has one hovered tile at a time
+	unsigned char m_definitionIndex = 0;
 };
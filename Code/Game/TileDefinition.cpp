@@ -2,7 +2,7 @@
 
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
-std::map<std::string, TileDefinition> TileDefinition::s_definitions;
+std::vector<TileDefinition> TileDefinition::s_definitions;
 
 
 TileDefinition::TileDefinition(XmlElement const* element)
@@ -10,6 +10,12 @@ TileDefinition::TileDefinition(XmlElement const* element)
 	m_name = ParseXmlAttribute(*element, "name", m_name);
 	m_cdataSymbol = ParseXmlAttribute(*element, "symbol", m_cdataSymbol);
 	m_isBlocked = ParseXmlAttribute(*element, "isBlocked", m_isBlocked);
+	m_movementCost = ParseXmlAttribute(*element, "movementCost", m_movementCost);
+
+	if (m_movementCost < 1 || m_movementCost > 255)
+	{
+		ERROR_AND_DIE(Stringf("Tile definition \"%s\" has movementCost %d, expected a value from 1 to 255", m_name.c_str(), m_movementCost));
+	}
 }
 
 void TileDefinition::InitializeTileDefinitions()
@@ -27,20 +33,51 @@ void TileDefinition::InitializeTileDefinitions()
 	while (tileDefElement)
 	{
 		TileDefinition tileDef(tileDefElement);
-		s_definitions[tileDef.m_name] = tileDef;
+
+		// Tiles store a one-byte index into this table, so a redefinition replaces its entry in place
+		int existingDefIndex = -1;
+		for (int tileDefIndex = 0; tileDefIndex < (int)s_definitions.size(); tileDefIndex++)
+		{
+			if (s_definitions[tileDefIndex].m_name == tileDef.m_name)
+			{
+				existingDefIndex = tileDefIndex;
+				break;
+			}
+		}
+
+		if (existingDefIndex >= 0)
+		{
+			tileDef.m_index = (unsigned char)existingDefIndex;
+			s_definitions[existingDefIndex] = tileDef;
+		}
+		else
+		{
+			if ((int)s_definitions.size() >= MAX_DEFINITIONS)
+			{
+				ERROR_AND_DIE(Stringf("Too many tile definitions, at most %d are supported", MAX_DEFINITIONS));
+			}
+			tileDef.m_index = (unsigned char)s_definitions.size();
+			s_definitions.push_back(tileDef);
+		}
+
 		tileDefElement = tileDefElement->NextSiblingElement();
 	}
 }
 
 TileDefinition* TileDefinition::GetTileDefinitionFromSymbol(char tileSymbol)
 {
-    for (auto tileDefIter = s_definitions.begin(); tileDefIter != s_definitions.end(); ++tileDefIter)
+	for (int tileDefIndex = 0; tileDefIndex < (int)s_definitions.size(); tileDefIndex++)
 	{
-		if (tileDefIter->second.m_cdataSymbol == tileSymbol)
+		if (s_definitions[tileDefIndex].m_cdataSymbol == tileSymbol)
 		{
-			return &tileDefIter->second;
+			return &s_definitions[tileDefIndex];
 		}
 	}
 
 	return nullptr;
 }
+
+TileDefinition const& TileDefinition::GetTileDefinitionFromIndex(unsigned char definitionIndex)
+{
+	return s_definitions[definitionIndex];
+}
@@ -2,7 +2,7 @@
 
 #include "Engine/Core/XMLUtils.hpp"
 
-#include <map>
+#include <vector>
 
 
 class TileDefinition
@@ -17,9 +17,14 @@ public:
 	char m_cdataSymbol = ' ';
 	std::string m_name = "";
 	bool m_isBlocked = false;
+	int m_movementCost = 1;
+	unsigned char m_index = 0;
 
 public:
-	static std::map<std::string, TileDefinition> s_definitions;
+	static constexpr int MAX_DEFINITIONS = 256;
+
+	static std::vector<TileDefinition> s_definitions;
 	static void InitializeTileDefinitions();
 	static TileDefinition* GetTileDefinitionFromSymbol(char tileSymbol);
+	static TileDefinition const& GetTileDefinitionFromIndex(unsigned char definitionIndex);
 };
@@ -4,6 +4,7 @@
 #include "Game/Game.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Map.hpp"
+#include "Game/Particle.hpp"
 #include "Game/Player.hpp"
 #include "Game/UnitDefinition.hpp"
 
@@ -27,10 +28,6 @@ Unit::Unit(UnitDefinition const& definition, Map* map, IntVec2 const& tileCoords
 	, m_owner(owner)
 	, m_health(m_definition.m_maxHealth)
 {
-	m_heatMap = new TileHeatMap(m_map->m_definition.m_dimensions);
-	std::vector<float> distanceField;
-	m_map->PopuplateDistanceField(distanceField, m_tileCoords);
-	m_heatMap->SetAllValues(distanceField);
 }
 
 void Unit::Update()
@@ -94,11 +91,15 @@ void Unit::Update()
 	}
 }
 
-void Unit::Render() const
+Mat44 Unit::GetModelTransform() const
 {
 	Mat44 transform = Mat44::CreateTranslation3D(m_position);
 	transform.Append(m_orientation.GetAsMatrix_iFwd_jLeft_kUp());
+	return transform;
+}
 
+Rgba8 Unit::GetModelColor() const
+{
 	Rgba8 modelColor = m_owner->GetTeamColor();
 	if (m_isSelected)
 	{
@@ -108,58 +109,31 @@ void Unit::Render() const
 	{
 		modelColor.MultiplyRGBScaled(Rgba8::WHITE, 0.5f);
 	}
+	return modelColor;
+}
 
-	g_renderer->SetBlendMode(BlendMode::OPAQUE);
-	g_renderer->SetDepthMode(DepthMode::ENABLED);
-	g_renderer->SetModelConstants(transform, modelColor);
-	g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_BACK);
-	g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
-	g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
-	g_renderer->BindTexture(nullptr);
-	g_renderer->BindShader(m_map->m_definition.m_shader);
-	g_renderer->DrawVertexBuffer(m_definition.m_model->GetVertexBuffer(), m_definition.m_model->GetVertexCount());
-
-	Vec3 sunDirection = m_owner->m_game->m_sunOrientation.GetAsMatrix_iFwd_jLeft_kUp().GetIBasis3D();
-	if (sunDirection.z < 0.f)
+void Unit::RenderFloatingDamage() const
+{
+	if (!m_floatingDamageTimer || m_floatingDamageTimer->HasDurationElapsed())
 	{
-		Vec3 groundIBasis(1.f, 0.f, 0.f);
-		Vec3 groundJBasis(0.f, 1.f, 0.f);
-		Vec3 groundKBasis(-(sunDirection.x / sunDirection.z), -(sunDirection.y / sunDirection.z), 0.f);
-		Vec3 groundTranslation(0.f, 0.f, 0.001f);
-		Mat44 shadowMatrix(groundIBasis, groundJBasis, groundKBasis, groundTranslation);
-		shadowMatrix.Append(transform);
-
-		Rgba8 shadowColor(0, 0, 0, 195);
-
-		g_renderer->SetBlendMode(BlendMode::ALPHA);
-		g_renderer->SetDepthMode(DepthMode::READ_ONLY_LESS_EQUAL);
-		g_renderer->SetModelConstants(shadowMatrix, shadowColor);
-		g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_BACK);
-		g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
-		g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
-		g_renderer->BindTexture(nullptr);
-		g_renderer->BindShader(m_map->m_definition.m_shader);
-		g_renderer->DrawVertexBuffer(m_definition.m_model->GetVertexBuffer(), m_definition.m_model->GetVertexCount());
+		return;
 	}
 
-	if (m_floatingDamageTimer && !m_floatingDamageTimer->HasDurationElapsed())
-	{
-		std::vector<Vertex_PCU> floatingDamageVerts;
-		Vec3 floatingDamagePosition = Interpolate(m_position + Vec3::SKYWARD * 0.4f, m_position + Vec3::SKYWARD * 0.8f, m_floatingDamageTimer->GetElapsedFraction());
-		Rgba8 floatingDamageColor = Interpolate(Rgba8::RED, Rgba8(255, 0, 0, 0), m_floatingDamageTimer->GetElapsedFraction());
-		g_butlerFont->AddVertsForText3D(floatingDamageVerts, Vec2::ZERO, 0.4f, m_floatingDamageStr, Rgba8::WHITE, 0.5f);
-		Mat44 floatingDamageTransform = GetBillboardMatrix(BillboardType::FULL_OPPOSING, m_map->m_game->m_worldCamera.GetModelMatrix(), floatingDamagePosition);
-
-		g_renderer->SetBlendMode(BlendMode::ALPHA);
-		g_renderer->SetDepthMode(DepthMode::DISABLED);
-		g_renderer->SetModelConstants(floatingDamageTransform, floatingDamageColor);
-		g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_NONE);
-		g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
-		g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
-		g_renderer->BindTexture(g_butlerFont->GetTexture());
-		g_renderer->BindShader(nullptr);
-		g_renderer->DrawVertexArray(floatingDamageVerts);
-	}
+	std::vector<Vertex_PCU> floatingDamageVerts;
+	Vec3 floatingDamagePosition = Interpolate(m_position + Vec3::SKYWARD * 0.4f, m_position + Vec3::SKYWARD * 0.8f, m_floatingDamageTimer->GetElapsedFraction());
+	Rgba8 floatingDamageColor = Interpolate(Rgba8::RED, Rgba8(255, 0, 0, 0), m_floatingDamageTimer->GetElapsedFraction());
+	g_butlerFont->AddVertsForText3D(floatingDamageVerts, Vec2::ZERO, 0.4f, m_floatingDamageStr, Rgba8::WHITE, 0.5f);
+	Mat44 floatingDamageTransform = GetBillboardMatrix(BillboardType::FULL_OPPOSING, m_map->m_game->m_worldCamera.GetModelMatrix(), floatingDamagePosition);
+
+	g_renderer->SetBlendMode(BlendMode::ALPHA);
+	g_renderer->SetDepthMode(DepthMode::DISABLED);
+	g_renderer->SetModelConstants(floatingDamageTransform, floatingDamageColor);
+	g_renderer->SetRasterizerCullMode(RasterizerCullMode::CULL_NONE);
+	g_renderer->SetRasterizerFillMode(RasterizerFillMode::SOLID);
+	g_renderer->SetSamplerMode(SamplerMode::POINT_CLAMP);
+	g_renderer->BindTexture(g_butlerFont->GetTexture());
+	g_renderer->BindShader(nullptr);
+	g_renderer->DrawVertexArray(floatingDamageVerts);
 }
 
 void Unit::Move(IntVec2 const& newTileCoords)
@@ -169,22 +143,42 @@ void Unit::Move(IntVec2 const& newTileCoords)
 		return;
 	}
 	
+	// Same search and board as the hover preview's query, so the unit drives exactly the path that was shown
+	std::vector<IntVec2> tileCoordsPath;
+	m_map->FindPath(tileCoordsPath, m_tileCoords, newTileCoords, m_definition.m_movementRange);
+	MoveAlongPath(tileCoordsPath);
+
+	//m_position = m_map->GetTileWorldPositionFromCoordinates(newTileCoords).ToVec3();
+}
+
+void Unit::MoveAlongPath(std::vector<IntVec2> const& tileCoordsPath)
+{
+	if (m_didMove || tileCoordsPath.empty())
+	{
+		return;
+	}
+
 	m_didMove = true;
-	m_tileCoords = newTileCoords;
+	// Recorded here rather than trusted from the last order, since a group-moved unit can end the turn without one
+	m_previousTileCoords = m_tileCoords;
+	m_map->RemoveUnitFromTile(this, m_tileCoords);
+	m_tileCoords = tileCoordsPath.back();
+	m_map->PlaceUnitOnTile(this, m_tileCoords);
 
 	std::vector<Vec2> path;
-	m_map->GenerateHeatMapPath(path, m_tileCoords, m_previousTileCoords, m_heatMap);
+	path.reserve(tileCoordsPath.size());
+	for (int pathIndex = 0; pathIndex < (int)tileCoordsPath.size(); pathIndex++)
+	{
+		path.push_back(m_map->GetTileWorldPositionFromCoordinates(tileCoordsPath[pathIndex]));
+	}
+	m_map->NotifyBoardChanged();
+	m_map->RefreshUnitVisibility(this);
 	m_pathLength = (int)path.size();
 
 	m_pathSpline = new CatmullRomSpline(path);
 	m_movementTimer = new Stopwatch(&m_map->m_game->m_gameClock, 1.f);
 	m_movementTimer->Start();
 	m_owner->m_game->m_isAnimationPlaying = true;
-
-	std::vector<float> newDistanceField;
-	m_map->PopuplateDistanceField(newDistanceField, m_tileCoords);
-	m_heatMap->SetAllValues(newDistanceField);
-	//m_position = m_map->GetTileWorldPositionFromCoordinates(newTileCoords).ToVec3();
 }
 
 void Unit::Attack(Unit* targetUnit)
@@ -227,7 +221,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Light Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_lightSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 12 dark smoke particles
 	for (int particleIndex = 0; particleIndex < 12; particleIndex++)
@@ -258,7 +252,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Dark Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_darkSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 3 type 1 fire particles
 	for (int particleIndex = 0; particleIndex < 3; particleIndex++)
@@ -287,7 +281,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 1", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash1Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 3 type 2 fire particles
 	for (int particleIndex = 0; particleIndex < 3; particleIndex++)
@@ -316,7 +310,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 2", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + unitFwd * particleOffset.x + unitLeft * particleOffset.y + unitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash2Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 
 	g_audio->StartSound(m_definition.m_fireSFX);
@@ -368,7 +362,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Light Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_lightSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 12 dark smoke particles
 	for (int particleIndex = 0; particleIndex < 12; particleIndex++)
@@ -399,7 +393,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Dark Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_darkSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 3 type 1 fire particles
 	for (int particleIndex = 0; particleIndex < 3; particleIndex++)
@@ -428,7 +422,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 1", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash1Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 3 type 2 fire particles
 	for (int particleIndex = 0; particleIndex < 3; particleIndex++)
@@ -457,7 +451,7 @@ void Unit::Attack(Unit* targetUnit)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 2", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(targetUnit->m_position + targetUnitFwd * particleOffset.x + targetUnitLeft * particleOffset.y + targetUnitUp * particleOffset.z, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash2Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 }
 
@@ -470,6 +464,13 @@ void Unit::HoldFire()
 
 void Unit::Cancel()
 {
+	// Another unit of a group move may have taken the tile this one left, and then the move stands
+	Unit* unitOnPreviousTile = m_map->GetUnitOnTile(m_previousTileCoords);
+	if (unitOnPreviousTile && unitOnPreviousTile != this)
+	{
+		return;
+	}
+
 	if (m_didMove)
 	{
 		m_didMove = false;
@@ -481,12 +482,12 @@ void Unit::Cancel()
 	delete m_movementTimer;
 	m_movementTimer = nullptr;
 
+	m_map->RemoveUnitFromTile(this, m_tileCoords);
 	m_tileCoords = m_previousTileCoords;
+	m_map->PlaceUnitOnTile(this, m_tileCoords);
 	m_position = m_map->GetTileWorldPositionFromCoordinates(m_previousTileCoords).ToVec3();
-
-	std::vector<float> newDistanceField;
-	m_map->PopuplateDistanceField(newDistanceField, m_tileCoords);
-	m_heatMap->SetAllValues(newDistanceField);
+	m_map->NotifyBoardChanged();
+	m_map->RefreshUnitVisibility(this);
 }
 
 void Unit::TakeDamage(int damage, Vec3 const& hitDirection)
@@ -535,7 +536,7 @@ void Unit::TakeDamage(int damage, Vec3 const& hitDirection)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position - hitDirection * 0.2f, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Light Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position - hitDirection * 0.2f, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_lightSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 6 dark smoke particles
 	for (int particleIndex = 0; particleIndex < 6; particleIndex++)
@@ -565,7 +566,7 @@ void Unit::TakeDamage(int damage, Vec3 const& hitDirection)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position - hitDirection * 0.2f, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Dark Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position - hitDirection * 0.2f, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_darkSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 6 fire particles (Sparks)
 	for (int particleIndex = 0; particleIndex < 6; particleIndex++)
@@ -595,7 +596,7 @@ void Unit::TakeDamage(int damage, Vec3 const& hitDirection)
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position - hitDirection * 0.2f, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 1", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position - hitDirection * 0.2f, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash1Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 }
 
@@ -604,6 +605,8 @@ void Unit::Die()
 	g_audio->StartSound(m_definition.m_deathSFX);
 	m_isDead = true;
 	m_isGarbage = true;
+	m_owner->m_visibilityMap.RemoveUnit(this);
+	m_map->RemoveUnitFromTile(this, m_tileCoords);
 
 	//---------------------------------------------------------------------------------------
 	// Death Effect
@@ -635,7 +638,7 @@ void Unit::Die()
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Light Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_lightSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 6 dark smoke particles
 	for (int particleIndex = 0; particleIndex < 6; particleIndex++)
@@ -664,7 +667,7 @@ void Unit::Die()
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Dark Smoke", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_darkSmokeSprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 6 type 1 fire particles
 	for (int particleIndex = 0; particleIndex < 6; particleIndex++)
@@ -693,7 +696,7 @@ void Unit::Die()
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 1", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash1Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 	// Spawn 6 type 2 fire particles
 	for (int particleIndex = 0; particleIndex < 6; particleIndex++)
@@ -722,6 +725,6 @@ void Unit::Die()
 		float startSpeedTime = 0.f;
 		float endSpeedTime = 1.f;
 
-		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, "Muzzle Flash 2", particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
+		g_app->m_game->SpawnParticle(m_position + particleOffset, particleVelocity, particleRotation, particleRotationSpeed, particleSize, particleLifetime, Particle::s_muzzleFlash2Sprite, particleColor, particleStartAlpha, particleEndAlpha, startAlphaTime, endAlphaTime, startScale, endScale, startScaleTime, endScaleTime, startSpeedMultiplier, endSpeedMultiplier, startSpeedTime, endSpeedTime);
 	}
 }
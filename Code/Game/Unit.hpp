@@ -3,8 +3,10 @@
 #include "Game/UnitDefinition.hpp"
 
 #include "Engine/Core/HeatMaps/TileHeatMap.hpp"
+#include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Stopwatch.hpp"
 #include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/Splines.hpp"
 #include "Engine/Math/Vec3.hpp"
 
@@ -21,9 +23,12 @@ public:
 	Unit(UnitDefinition const& definition, Map* map, IntVec2 const& tileCoords, Vec3 const& position, EulerAngles const& orientation, Player* owner);
 
 	void Update();
-	void Render() const;
+	Mat44 GetModelTransform() const;
+	Rgba8 GetModelColor() const;
+	void RenderFloatingDamage() const;
 
 	void Move(IntVec2 const& newTileCoords);
+	void MoveAlongPath(std::vector<IntVec2> const& tileCoordsPath);
 	void Attack(Unit* targetUnit);
 	void HoldFire();
 	void Cancel();
@@ -50,7 +55,6 @@ public:
 	IntVec2 m_currentTileCoords = IntVec2::ZERO;
 	bool m_didMove = false;
 	bool m_ordersIssued = false;
-	TileHeatMap* m_heatMap = nullptr;
 
 	bool m_isMoving = false;
 	int m_pathLength = -1;
@@ -39,6 +39,7 @@ UnitDefinition::UnitDefinition(XmlElement const* element)
 	int attackRangeMax = ParseXmlAttribute(*element, "groundAttackRangeMax", 0);
 	m_attackRange = IntRange(attackRangeMin, attackRangeMax);
 	m_movementRange = ParseXmlAttribute(*element, "movementRange", m_movementRange);
+	m_sightRange = ParseXmlAttribute(*element, "sightRange", m_sightRange);
 	m_defense = ParseXmlAttribute(*element, "defense", m_defense);
 	m_maxHealth = ParseXmlAttribute(*element, "health", m_maxHealth);
 
@@ -83,6 +84,29 @@ void UnitDefinition::InitializeUnitDefinitions()
 	}
 }
 
+int UnitDefinition::GetMaxRange()
+{
+	int maxRange = 0;
+	for (auto unitDefIter = s_definitions.begin(); unitDefIter != s_definitions.end(); ++unitDefIter)
+	{
+		UnitDefinition const& unitDef = unitDefIter->second;
+		if (unitDef.m_attackRange.m_max > maxRange)
+		{
+			maxRange = unitDef.m_attackRange.m_max;
+		}
+		if (unitDef.m_movementRange > maxRange)
+		{
+			maxRange = unitDef.m_movementRange;
+		}
+		if (unitDef.m_sightRange > maxRange)
+		{
+			maxRange = unitDef.m_sightRange;
+		}
+	}
+
+	return maxRange;
+}
+
 UnitType GetUnitTypeFromString(std::string unitTypeStr)
 {
 	if (!strcmp(unitTypeStr.c_str(), "Tank"))
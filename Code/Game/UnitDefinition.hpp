@@ -37,6 +37,7 @@ public:
 	int m_attackDamage = 0;
 	IntRange m_attackRange = IntRange::ZERO;
 	int m_movementRange = 0;
+	int m_sightRange = 0;
 	int m_defense = 0;
 	int m_maxHealth = 0;
 	Vec3 m_muzzleOffset = Vec3::ZERO;
@@ -47,5 +48,6 @@ public:
 
 public:
 	static void InitializeUnitDefinitions();
+	static int GetMaxRange();
 	static std::map<std::string, UnitDefinition> s_definitions;
 };
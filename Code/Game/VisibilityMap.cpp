@@ -0,0 +1,45 @@
+#include "Game/VisibilityMap.hpp"
+
+
+void VisibilityMap::Initialize(int numTiles)
+{
+	m_numViewersPerTile.assign(numTiles, 0);
+	m_visibleTileIndexesByUnit.clear();
+}
+
+void VisibilityMap::SetUnitVisibleTiles(Unit const* unit, std::vector<int> const& visibleTileIndexes)
+{
+	std::vector<int>& unitVisibleTileIndexes = m_visibleTileIndexesByUnit[unit];
+	RemoveViewer(unitVisibleTileIndexes);
+
+	unitVisibleTileIndexes = visibleTileIndexes;
+	for (int visibleIndex = 0; visibleIndex < (int)unitVisibleTileIndexes.size(); visibleIndex++)
+	{
+		m_numViewersPerTile[unitVisibleTileIndexes[visibleIndex]]++;
+	}
+}
+
+void VisibilityMap::RemoveUnit(Unit const* unit)
+{
+	auto unitIter = m_visibleTileIndexesByUnit.find(unit);
+	if (unitIter == m_visibleTileIndexesByUnit.end())
+	{
+		return;
+	}
+
+	RemoveViewer(unitIter->second);
+	m_visibleTileIndexesByUnit.erase(unitIter);
+}
+
+bool VisibilityMap::IsTileVisible(int tileIndex) const
+{
+	return m_numViewersPerTile[tileIndex] > 0;
+}
+
+void VisibilityMap::RemoveViewer(std::vector<int> const& visibleTileIndexes)
+{
+	for (int visibleIndex = 0; visibleIndex < (int)visibleTileIndexes.size(); visibleIndex++)
+	{
+		m_numViewersPerTile[visibleTileIndexes[visibleIndex]]--;
+	}
+}
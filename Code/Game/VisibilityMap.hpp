@@ -0,0 +1,26 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+
+class Unit;
+
+
+// Fog of war for one player: m_numViewersPerTile[i] counts the player's units that can see tile i
+// Each unit's visible tiles are cached so a move or death only withdraws and re-adds that one unit's contribution
+class VisibilityMap
+{
+public:
+	void Initialize(int numTiles);
+	void SetUnitVisibleTiles(Unit const* unit, std::vector<int> const& visibleTileIndexes);
+	void RemoveUnit(Unit const* unit);
+	bool IsTileVisible(int tileIndex) const;
+
+private:
+	void RemoveViewer(std::vector<int> const& visibleTileIndexes);
+
+public:
+	std::vector<unsigned short> m_numViewersPerTile;
+	std::map<Unit const*, std::vector<int>> m_visibleTileIndexesByUnit;
+};